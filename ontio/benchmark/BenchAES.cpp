@@ -0,0 +1,74 @@
+#include "../src/crypto/AES.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <openssl/evp.h>
+
+// items is how many keys one call of f encrypts, results are per key
+template <class F>
+static void run(const char *name, size_t count, F f, size_t items = 1) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    f();
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count * items / sec << " key/s" << std::endl;
+}
+
+// what every keystore entry used to pay: a context allocated and the
+// cipher and key set up from scratch
+static size_t freshContext(const std::vector<unsigned char> &key,
+                           const std::vector<unsigned char> &iv,
+                           const std::vector<unsigned char> &plaintext) {
+  std::vector<unsigned char> out(plaintext.size() + AesGcm::TAG_SIZE);
+  int len = 0;
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL);
+  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, (int)iv.size(), NULL);
+  EVP_EncryptInit_ex(ctx, NULL, NULL, key.data(), iv.data());
+  EVP_EncryptUpdate(ctx, out.data(), &len, plaintext.data(),
+                    (int)plaintext.size());
+  EVP_EncryptFinal_ex(ctx, out.data() + len, &len);
+  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, AesGcm::TAG_SIZE,
+                      out.data() + plaintext.size());
+  EVP_CIPHER_CTX_free(ctx);
+  return out.size();
+}
+
+int main() {
+  const size_t count = 65536;
+  const size_t batch = 256;
+  std::vector<unsigned char> key(32, 0x11);
+  std::vector<unsigned char> iv(12, 0x22);
+  std::vector<unsigned char> aad(34, 'A');
+  // a private key, as a keystore stores it
+  std::vector<unsigned char> plaintext(32, 0x33);
+  volatile size_t sink = 0;
+
+  run("fresh context per key", count,
+      [&]() { sink += freshContext(key, iv, plaintext); });
+  run("AES::gcmEncrypt", count, [&]() {
+    sink += AES::gcmEncrypt(plaintext, key, iv, false, aad).size();
+  });
+  AesGcm gcm(key);
+  run("AesGcm reused", count,
+      [&]() { sink += gcm.encrypt(plaintext, iv, aad).size(); });
+
+  std::vector<std::vector<unsigned char>> plaintexts(batch, plaintext);
+  std::vector<std::vector<unsigned char>> keys(batch, key);
+  std::vector<std::vector<unsigned char>> ivs(batch, iv);
+  std::vector<std::vector<unsigned char>> aads(batch, aad);
+  run("AES::gcmEncryptBatch", count / batch, [&]() {
+    sink += AES::gcmEncryptBatch(plaintexts, keys, ivs, aads).size();
+  }, batch);
+  return 0;
+}
@@ -0,0 +1,10 @@
+#!/bin/bash
+path=$(
+	cd $(dirname $0)
+	pwd
+)
+cd $path
+g++ BenchAES.cpp $(pkg-config --cflags --libs openssl) -std=c++11 -O2 -o ../bin/bench
+../bin/bench
+rm ../bin/bench &&
+cd $path/../
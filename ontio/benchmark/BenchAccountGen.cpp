@@ -0,0 +1,43 @@
+#include "../src/account/Account.h"
+#include "../src/account/AccountGenerator.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+template <class F> static void run(const char *name, size_t count, F f) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  f(count);
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(32) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count / sec << " account/s" << std::endl;
+}
+
+int main() {
+  const size_t count = 20000;
+  volatile size_t sink = 0;
+
+  run("Account::create + toBase58", count, [&](size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      Account account = Account::create();
+      sink += account.getAddressU160().toBase58().size();
+    }
+  });
+  run("generateAccounts, 1 thread", count, [&](size_t n) {
+    AccountGenerator::generateAccounts(
+        n, 1, [&](const GeneratedAccount &a) { sink += a.address.size(); });
+  });
+  std::string all = "generateAccounts, all cores (" +
+                    std::to_string(std::thread::hardware_concurrency()) + ")";
+  run(all.c_str(), count, [&](size_t n) {
+    AccountGenerator::generateAccounts(
+        n, 0, [&](const GeneratedAccount &a) { sink += a.address.size(); });
+  });
+  return 0;
+}
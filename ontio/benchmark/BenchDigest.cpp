@@ -0,0 +1,75 @@
+#include "../src/crypto/Digest.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// single threaded, so the numbers are throughput per core
+template <class F> static double seconds(F f, int rounds) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    f();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+             .count();
+}
+
+static const char *name(Sha256Impl impl) {
+  switch (impl) {
+  case Sha256Impl::OPENSSL:
+    return "openssl";
+  case Sha256Impl::AVX2:
+    return "avx2 x8";
+  default:
+    return "auto";
+  }
+}
+
+int main() {
+  const size_t count = 4096;
+  const size_t sizes[] = {32, 64, 256, 1024};
+  const Sha256Impl impls[] = {Sha256Impl::OPENSSL, Sha256Impl::AVX2,
+                              Sha256Impl::AUTO};
+  std::cout << "auto resolves to " << name(Sha256Batch::resolve(Sha256Impl::AUTO))
+            << std::endl;
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    std::vector<std::vector<unsigned char>> messages(
+        count, std::vector<unsigned char>(sizes[s]));
+    for (size_t i = 0; i < count; i++) {
+      for (size_t j = 0; j < sizes[s]; j++) {
+        messages[i][j] = (unsigned char)(i + j);
+      }
+    }
+    int rounds = (int)(64 * 1024 * 1024 / (count * sizes[s])) + 1;
+    std::cout << "-- hash256Batch, " << count << " x " << sizes[s]
+              << " bytes" << std::endl;
+    for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++) {
+      double sec = seconds(
+          [&]() { Digest::hash256Batch(messages, impls[k]); }, rounds);
+      double hashes = (double)count * rounds / sec;
+      std::cout << std::left << std::setw(10) << name(impls[k]) << std::right
+                << std::fixed << std::setprecision(2) << std::setw(10)
+                << hashes / 1e6 << " Mhash/s" << std::setw(10)
+                << hashes * sizes[s] / (1 << 20) << " MB/s" << std::endl;
+    }
+  }
+
+  std::vector<Digest::Hash256> leaves(count);
+  for (size_t i = 0; i < count; i++) {
+    leaves[i] = Digest::hash256((const unsigned char *)&i, sizeof(i));
+  }
+  std::cout << "-- merkleRoot, " << count << " leaves" << std::endl;
+  for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++) {
+    int rounds = 200;
+    double sec =
+        seconds([&]() { Digest::merkleRoot(leaves, impls[k]); }, rounds);
+    std::cout << std::left << std::setw(10) << name(impls[k]) << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << rounds / sec << " roots/s" << std::endl;
+  }
+  return 0;
+}
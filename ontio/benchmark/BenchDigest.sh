@@ -0,0 +1,11 @@
+#!/bin/bash
+path=$(
+	cd $(dirname $0)
+	pwd
+)
+cd $path
+# the AVX2 path is picked at runtime, no -mavx2 needed
+g++ BenchDigest.cpp $(pkg-config --cflags --libs openssl) -std=c++11 -O2 -o ../bin/bench
+../bin/bench
+rm ../bin/bench &&
+cd $path/../
@@ -0,0 +1,100 @@
+#include "../src/common/Helper.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// the stringstream based codec Helper used before Hex.h, kept for comparison
+static std::string legacyToHexString(const std::vector<unsigned char> &value) {
+  std::stringstream stream;
+  stream << "0x";
+  for (size_t i = 0; i < value.size(); i++) {
+    stream << std::setfill('0') << std::setw(2) << std::hex
+           << (unsigned int)value[i];
+  }
+  return stream.str();
+}
+
+static std::vector<unsigned char> legacyHexToBytes(std::string value) {
+  std::vector<unsigned char> ret_vec;
+  size_t i = 0;
+  while (i < value.size()) {
+    i += 2;
+    value.insert(i, 1, ' ');
+    i += 1;
+  }
+  std::istringstream hex_chars_stream(value);
+  unsigned int c;
+  while (hex_chars_stream >> std::hex >> c) {
+    ret_vec.push_back(c);
+  }
+  return ret_vec;
+}
+
+static std::vector<unsigned char> legacyHexStringToByte(const std::string &str) {
+  std::vector<unsigned char> byte_vec;
+  for (size_t i = 0; i < str.size(); i += 2) {
+    unsigned char uc[2];
+    for (int j = 0; j < 2; j++) {
+      char c = str[i + j];
+      if ('a' <= c && c <= 'z') {
+        uc[j] = c - 'a' + 10;
+      } else if ('A' <= c && c <= 'Z') {
+        uc[j] = c - 'A' + 10;
+      } else if ('0' <= c && c <= '9') {
+        uc[j] = c - '0';
+      } else {
+        throw std::runtime_error("string isn't hexString.");
+      }
+    }
+    byte_vec.push_back((uc[0] << 4) | uc[1]);
+  }
+  return byte_vec;
+}
+
+template <class F> static void run(const char *name, size_t bytes, F f) {
+  // warm up, then time enough rounds for about 16MB of input
+  f();
+  size_t rounds = (16u << 20) / bytes + 1;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    f();
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(1)
+            << bytes * rounds / sec / (1 << 20) << " MB/s" << std::endl;
+}
+
+int main() {
+  const size_t sizes[] = {32, 256, 4096};
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    std::vector<unsigned char> bytes(sizes[n]);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = (unsigned char)(i * 131 + 7);
+    }
+    std::string hex = Helper::toHexString(bytes).substr(2);
+    volatile size_t sink = 0;
+
+    std::cout << "-- " << sizes[n] << " bytes" << std::endl;
+    run("legacy toHexString", bytes.size(),
+        [&]() { sink += legacyToHexString(bytes).size(); });
+    run("toHexString", bytes.size(),
+        [&]() { sink += Helper::toHexString(bytes).size(); });
+    run("legacy hexToBytes", bytes.size(),
+        [&]() { sink += legacyHexToBytes(hex).size(); });
+    run("hexToBytes", bytes.size(),
+        [&]() { sink += Helper::hexToBytes(hex).size(); });
+    run("legacy hexStringToByte", bytes.size(),
+        [&]() { sink += legacyHexStringToByte(hex).size(); });
+    run("hexStringToByte", bytes.size(),
+        [&]() { sink += Helper::hexStringToByte(hex).size(); });
+  }
+  return 0;
+}
@@ -0,0 +1,11 @@
+#!/bin/bash
+path=$(
+	cd $(dirname $0)
+	pwd
+)
+cd $path
+# add -mavx2 to CXXFLAGS to benchmark the AVX2 path
+g++ BenchHex.cpp $(pkg-config --cflags --libs openssl) -std=c++11 -O2 $CXXFLAGS -o ../bin/bench
+../bin/bench
+rm ../bin/bench &&
+cd $path/../
@@ -0,0 +1,70 @@
+#include "../src/network/restful/RestClient.h"
+#include "../src/network/rpc/RpcClient.h"
+#include "../test/MockHttpServer.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+template <class F> static void run(const char *name, size_t count, F f) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    f();
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count / sec << " call/s" << std::endl;
+}
+
+// the same reads over JSON-RPC and over REST from one local mock node
+// answering both. Both clients share the CurlPool transport and neither
+// logs, so the difference is the client side of each protocol.
+int main() {
+  const size_t count = 2000;
+  nlohmann::json block = {{"Hash", std::string(64, 'a')},
+                          {"Header", {{"Height", 4242}}},
+                          {"Transactions", nlohmann::json::array()}};
+  for (int i = 0; i < 20; i++) {
+    block["Transactions"].push_back(
+        {{"Hash", std::string(64, 'b')}, {"Payload", std::string(400, 'c')}});
+  }
+  MockHttpServer node([&block](const std::string &method,
+                               const std::string &path,
+                               const std::string &body) {
+    nlohmann::json response;
+    if (method == "POST") {
+      std::string call = nlohmann::json::parse(body)["method"];
+      response = {{"jsonrpc", "2.0"}, {"id", 1}, {"error", 0}};
+      response["result"] = call == "getblock" ? block : nlohmann::json(4242);
+    } else {
+      response = {{"Action", "getblock"},
+                  {"Desc", "SUCCESS"},
+                  {"Error", 0},
+                  {"Version", "1.0.0"}};
+      response["Result"] = path == "/api/v1/block/height"
+                               ? nlohmann::json(4242)
+                               : block;
+    }
+    return response.dump();
+  });
+  RpcClient rpc(node.url());
+  RestClient rest(node.url());
+  volatile size_t sink = 0;
+
+  std::cout << "one keep-alive connection, same transport, no logging"
+            << std::endl;
+  run("RPC getBlockHeight", count, [&]() { sink += rpc.getBlockHeight(); });
+  run("REST getBlockHeight", count, [&]() { sink += rest.getBlockHeight(); });
+  run("RPC getBlockJson", count,
+      [&]() { sink += rpc.getBlockJson(4242).size(); });
+  run("REST getBlockJson", count,
+      [&]() { sink += rest.getBlockJson(4242).size(); });
+  std::cout << "connections opened: " << node.connections() << std::endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "../src/network/connect/CurlPool.h"
+#include "../src/network/rpc/RpcInterfaces.h"
+#include "../src/sdk/manager/AsyncConnectMgr.h"
+#include "../test/MockHttpServer.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// items is how many calls one f() makes, results are per call
+template <class F>
+static void run(const char *name, size_t count, F f, size_t items = 1) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    f();
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count * items / sec << " call/s" << std::endl;
+}
+
+// round trips to a local mock node, so the numbers are the client and
+// connection overhead and nothing else
+int main() {
+  const size_t count = 2000;
+  MockHttpServer node([](const std::string &, const std::string &,
+                          const std::string &body) {
+    if (body.empty() || body[0] != '[') {
+      return std::string(
+          "{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":0,\"result\":4242}");
+    }
+    nlohmann::json request = nlohmann::json::parse(body);
+    nlohmann::json response = nlohmann::json::array();
+    for (size_t i = 0; i < request.size(); i++) {
+      response.push_back({{"jsonrpc", "2.0"},
+                          {"id", request[i]["id"]},
+                          {"error", 0},
+                          {"result", 4242}});
+    }
+    return response.dump();
+  });
+  std::string url = node.url();
+  std::string request = "{\"jsonrpc\":\"2.0\",\"method\":\"getblockcount\","
+                        "\"params\":[],\"id\":1}";
+  volatile size_t sink = 0;
+
+  // what every call used to do: a new handle and a new connection
+  run("new connection per call", count, [&]() {
+    CurlPool::clear();
+    sink += CurlPool::post(url, request, false).size();
+  });
+  CurlPool::clear();
+  run("pooled keep-alive handle", count,
+      [&]() { sink += CurlPool::post(url, request, false).size(); });
+
+  // one thread, up to 256 requests in flight over 8 connections
+  AsyncConnectMgr async(url, std::make_shared<CurlMultiLoop>(60000, 8));
+  const size_t window = 256;
+  run("async, 256 in flight", count / window, [&]() {
+    std::vector<std::future<int>> heights;
+    for (size_t i = 0; i < window; i++) {
+      heights.push_back(async.getBlockHeight());
+    }
+    for (size_t i = 0; i < window; i++) {
+      sink += heights[i].get();
+    }
+  }, window);
+
+  const size_t batch = 500;
+  RpcInterfaces rpc(url);
+  std::vector<std::pair<std::string, nlohmann::json>> calls(
+      batch,
+      std::make_pair(std::string("getblockcount"), nlohmann::json::array()));
+  run("JSON-RPC batch of 500", count / batch,
+      [&]() { sink += rpc.callBatch(calls).size(); }, batch);
+  std::cout << "connections opened: " << node.connections() << std::endl;
+
+  // where the node, not the client, is the bottleneck
+  MockHttpServer slow_node([](const std::string &, const std::string &,
+                              const std::string &) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return std::string(
+        "{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":0,\"result\":4242}");
+  });
+  std::string slow_url = slow_node.url();
+  run("1 ms node, pooled", count / 4,
+      [&]() { sink += CurlPool::post(slow_url, request, false).size(); });
+  AsyncConnectMgr slow_async(slow_url,
+                             std::make_shared<CurlMultiLoop>(60000, 64));
+  run("1 ms node, async 256", count / window, [&]() {
+    std::vector<std::future<int>> heights;
+    for (size_t i = 0; i < window; i++) {
+      heights.push_back(slow_async.getBlockHeight());
+    }
+    for (size_t i = 0; i < window; i++) {
+      sink += heights[i].get();
+    }
+  }, window);
+  return 0;
+}
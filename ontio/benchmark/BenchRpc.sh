@@ -0,0 +1,10 @@
+#!/bin/bash
+path=$(
+	cd $(dirname $0)
+	pwd
+)
+cd $path
+g++ BenchRpc.cpp $(pkg-config --cflags --libs openssl libcurl) -std=c++11 -O2 -pthread -o ../bin/bench
+../bin/bench
+rm ../bin/bench &&
+cd $path/../
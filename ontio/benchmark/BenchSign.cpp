@@ -0,0 +1,42 @@
+#include "../src/account/Account.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+template <class F> static void run(const char *name, size_t count, F f) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    f();
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count / sec << " op/s" << std::endl;
+}
+
+int main() {
+  const size_t count = 4096;
+  std::vector<unsigned char> digest(32, 0x5a);
+  Account ecdsa = Account::create(SignatureScheme::SHA256withECDSA);
+  Account eddsa = Account::create(SignatureScheme::SHA512withEDDSA);
+
+  std::vector<Signature> ecdsa_sig(1, Signature(ecdsa.generateSignature(digest)));
+  std::vector<Signature> eddsa_sig(1, Signature(eddsa.generateSignature(digest)));
+  volatile size_t sink = 0;
+
+  run("P-256 ECDSA sign", count,
+      [&]() { sink += ecdsa.generateSignature(digest).size(); });
+  run("Ed25519 sign", count,
+      [&]() { sink += eddsa.generateSignature(digest).size(); });
+  run("P-256 ECDSA verify", count,
+      [&]() { sink += ecdsa.verifySignature(digest, ecdsa_sig); });
+  run("Ed25519 verify", count,
+      [&]() { sink += eddsa.verifySignature(digest, eddsa_sig); });
+  return 0;
+}
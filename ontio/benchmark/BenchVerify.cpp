@@ -0,0 +1,69 @@
+#include "../src/account/Account.h"
+#include "../src/crypto/BatchVerifier.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char *private_keys[] = {
+    "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de",
+    "49855b16636e70f100cc5f4f42bc20a6535d7414fb8845e7310f8dd065a97221",
+    "1094e90dd7c4fdfd849c14798d725ac351ae0d924b29a279a9ffa77d5737bd96"};
+
+template <class F> static void run(const char *name, size_t count, F f) {
+  f();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  size_t valid = f();
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  std::cout << std::left << std::setw(28) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << count / sec << " verify/s  (" << valid << "/" << count
+            << " valid)" << std::endl;
+}
+
+int main() {
+  const size_t count = 2048;
+  std::vector<VerifyItem> items(count);
+  std::vector<std::string> public_keys(count);
+  for (size_t i = 0; i < count; i++) {
+    Account account(private_keys[i % 3]);
+    std::vector<unsigned char> data(4, (unsigned char)i);
+    public_keys[i] = account.serializePublicKey_str();
+    items[i].publicKey = Helper::hexStringToByte(public_keys[i]);
+    items[i].digest = Digest::hash256(Digest::sha256(data));
+    items[i].signature = account.generateSignature(items[i].digest);
+    items[i].signature.erase(items[i].signature.begin());
+  }
+
+  SignatureHandler handler(KeyType::ECDSA, SignatureScheme::SHA256withECDSA,
+                           CurveName::p256);
+  run("SignatureHandler", count, [&]() {
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+      valid += handler.verifySignature(public_keys[i], items[i].digest,
+                                       items[i].signature);
+    }
+    return valid;
+  });
+
+  unsigned int cores = std::thread::hardware_concurrency();
+  for (size_t threads = 1; threads <= cores; threads *= 2) {
+    BatchVerifier verifier(threads);
+    std::string name = "BatchVerifier x" + std::to_string(threads);
+    run(name.c_str(), count, [&]() {
+      std::vector<bool> result = verifier.verify(items);
+      size_t valid = 0;
+      for (size_t i = 0; i < result.size(); i++) {
+        valid += result[i];
+      }
+      return valid;
+    });
+  }
+  return 0;
+}
@@ -73,26 +73,7 @@ ConnectMgr OntSdk::getConnect() {
 
 void OntSdk::signTx(InvokeCodeTransaction &tx,
                     const std::vector<Account> &accounts) {
-    if (accounts.size() > Common::TX_MAX_SIG_SIZE) {
-        throw SDKException(ErrorCode::StrParamErr(
-                "the number of transaction signatures should not be over 16"));
-    }
-    std::vector<Sig> sigs;
-    sigs.reserve(accounts.size());
-    for (size_t i = 0; i < accounts.size(); i++) {
-        Sig sig_item;
-        for (size_t j = 0; j < accounts.size(); j++) {
-            std::vector<unsigned char> pub_key;
-            std::vector<unsigned char> signature;
-            pub_key = accounts[j].serializePublicKey();
-            signature = tx.sign(accounts[j], defaultSignScheme, defaultCurveName);
-            sig_item.add_M();
-            sig_item.add_pubKeys(pub_key);
-            sig_item.add_sigData(signature);
-        }
-        sigs.push_back(sig_item);
-    }
-    tx.add_sigs(sigs);
+    SignService::signTx(tx, accounts);
 }
 
 void OntSdk::addSign(InvokeCodeTransaction &tx, const Account &acct) {
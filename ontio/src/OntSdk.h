@@ -16,6 +16,7 @@
 #include "crypto/Signature.h"
 #include "sdk/manager/ConnectMgr.h"
 #include "sdk/manager/OntAssetTx.h"
+#include "sdk/manager/SignService.h"
 #include "sdk/manager/WalletMgr.h"
 
 class Vm;
@@ -5,6 +5,7 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <future>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "../crypto/AES.h"
 #include "../crypto/KeyType.hpp"
 #include "../crypto/ScryptHandler.h"
+#include "../crypto/ScryptPool.h"
 #include "../crypto/Signature.h"
 #include "../crypto/SignatureHandler.h"
 #include "../crypto/SignatureScheme.h"
@@ -30,8 +32,23 @@ private:
   SignatureScheme signatureScheme;
   CurveName curveName;
   std::string sm2Param;
+  // parsed once from privateKey, shared between copies
+  ECKey ecKey;
 
 private:
+  static void checkGcmEncryptedPrikey(const std::string &encryptedPriKey,
+                                      const std::vector<unsigned char> &salt)
+  {
+    if (encryptedPriKey.length() == 0)
+    {
+      throw new SDKException(ErrorCode::EncryptedPriKeyError);
+    }
+    if (salt.size() != 16)
+    {
+      throw new SDKException(ErrorCode::ParamError);
+    }
+  }
+
   void parsePublicKey(const std::vector<unsigned char> &data)
   {
     if (data.size() == 0)
@@ -46,7 +63,7 @@ private:
     {
       keyType = KeyType::ECDSA;
     }
-    else if (data.size() == 35)
+    else if (data.size() == 34 || data.size() == 35)
     {
       keyType = KeyTypeMethod::fromLabel(data[0]);
     }
@@ -57,6 +74,14 @@ private:
       curveParams = CurveNameMethod::toString(CurveName::p256);
       break;
     }
+    case KeyType::EDDSA:
+    {
+      curveName = CurveName::ED25519;
+      curveParams = CurveNameMethod::toString(curveName);
+      signatureScheme = SignatureScheme::SHA512withEDDSA;
+      publicKey = Helper::toHexString(data.data(), data.size());
+      break;
+    }
     case KeyType::SM2:
       break;
     default:
@@ -64,6 +89,16 @@ private:
     }
   }
 
+  // key type label || curve label || 32 byte key, as Ontology serializes
+  // EdDSA public keys
+  static std::string eddsaPublicKey(const ECKey &key)
+  {
+    unsigned char labels[2] = {
+        (unsigned char)KeyTypeMethod::getLabel(KeyType::EDDSA),
+        (unsigned char)CurveNameMethod::getLabel(CurveName::ED25519)};
+    return Helper::toHexString(labels, sizeof(labels)) + key.getPublicKeyHex();
+  }
+
 public:
   Account() {}
 
@@ -90,6 +125,10 @@ public:
     {
       keyType = KeyType::ECDSA;
     }
+    else if (signatureScheme == SignatureScheme::SHA512withEDDSA)
+    {
+      keyType = KeyType::EDDSA;
+    }
     else
     {
       throw std::runtime_error("SignatureScheme Error!");
@@ -99,13 +138,23 @@ public:
     case SignatureScheme::SHA256withECDSA:
     {
       privateKey = private_key;
-      publicKey = Signature::EC_get_pubkey_by_prikey(privateKey, curveName);
+      ecKey = ECKey(privateKey, curveName);
+      publicKey = ecKey.getPublicKeyHex();
       // ec_key = ec_sign.get_EC_key();
       std::vector<unsigned char> uc_pub_key;
       uc_pub_key = serializePublicKey();
       addressU160 = Address::addressFromPubKey(uc_pub_key);
       break;
     }
+    case SignatureScheme::SHA512withEDDSA:
+    {
+      privateKey = private_key;
+      curveName = CurveName::ED25519;
+      ecKey = ECKey(privateKey, curveName);
+      publicKey = eddsaPublicKey(ecKey);
+      addressU160 = Address::addressFromPubKey(serializePublicKey());
+      break;
+    }
     case SignatureScheme::SM3withSM2:
     {
       throw std::runtime_error("SignatureScheme Unsupport");
@@ -183,6 +232,7 @@ public:
     this->signatureScheme = acct.signatureScheme;
     this->curveName = acct.curveName;
     this->sm2Param = acct.sm2Param;
+    this->ecKey = acct.ecKey;
     return *this;
   }
 
@@ -196,6 +246,7 @@ public:
     this->signatureScheme = acct->signatureScheme;
     this->curveName = acct->curveName;
     this->sm2Param = acct->sm2Param;
+    this->ecKey = acct->ecKey;
     return this;
   }
 
@@ -217,6 +268,10 @@ public:
     {
       keyType = KeyType::ECDSA;
     }
+    else if (signatureScheme == SignatureScheme::SHA512withEDDSA)
+    {
+      keyType = KeyType::EDDSA;
+    }
     else
     {
       throw "SignatureScheme Error!";
@@ -226,12 +281,22 @@ public:
     case SignatureScheme::SHA256withECDSA:
     {
       privateKey = private_key;
-      publicKey = Signature::EC_get_pubkey_by_prikey(privateKey, curveName);
+      ecKey = ECKey(privateKey, curveName);
+      publicKey = ecKey.getPublicKeyHex();
       std::vector<unsigned char> uc_pub_key;
       uc_pub_key = serializePublicKey();
       addressU160 = Address::addressFromPubKey(uc_pub_key);
       break;
     }
+    case SignatureScheme::SHA512withEDDSA:
+    {
+      privateKey = private_key;
+      this->curveName = CurveName::ED25519;
+      ecKey = ECKey(privateKey, this->curveName);
+      publicKey = eddsaPublicKey(ecKey);
+      addressU160 = Address::addressFromPubKey(serializePublicKey());
+      break;
+    }
     case SignatureScheme::SM3withSM2:
     {
       throw std::runtime_error("SignatureScheme Unsupport");
@@ -284,6 +349,16 @@ public:
     }
   }
 
+  // a new account with a random key, on P-256 or Ed25519 by scheme
+  static Account
+  create(SignatureScheme scheme = SignatureScheme::SHA256withECDSA)
+  {
+    CurveName curve = scheme == SignatureScheme::SHA512withEDDSA
+                          ? CurveName::ED25519
+                          : CurveName::p256;
+    return Account(ECKey::generate(curve).getPrivateKeyHex(), scheme, curve);
+  }
+
   Address getAddressU160() const { return addressU160; }
 
   SignatureScheme getSignatureScheme() { return signatureScheme; }
@@ -292,7 +367,14 @@ public:
 
   std::vector<unsigned char> generateSignature(std::vector<unsigned char> msg)
   {
-    if (msg.empty())
+    return generateSignature(msg.data(), msg.size());
+  }
+
+  // msg is the digest to sign, returns scheme byte || r || s
+  std::vector<unsigned char> generateSignature(const unsigned char *msg,
+                                               size_t len)
+  {
+    if (len == 0)
     {
       throw new runtime_error(ErrorCode::StrInvalidMessage);
     }
@@ -307,9 +389,24 @@ public:
         sm2Param = "1234567812345678";
       }
     }
+    if (ecKey.empty())
+    {
+      ecKey = ECKey(privateKey, curveName);
+    }
+    if (keyType == KeyType::EDDSA)
+    {
+      return Signature::toBytes(signatureScheme,
+                                SignatureHandler::EDDSA_sign_raw(ecKey, msg, len));
+    }
+    if (curveName == CurveName::p256 &&
+        signatureScheme != SignatureScheme::SM3withSM2)
+    {
+      return Signature::toBytes(signatureScheme,
+                                SignatureHandler::ECDSA_sign_raw(ecKey, msg, len));
+    }
     std::vector<unsigned char> sign_data;
-    SignatureHandler sign_handler(keyType, signatureScheme, curveName);
-    sign_data = sign_handler.generateSignature(privateKey, msg, sm2Param);
+    sign_data = SignatureHandler::ECDSA_sign_digest(
+        ecKey, std::vector<unsigned char>(msg, msg + len), curveName);
     Signature signature(signatureScheme, sign_data, sm2Param);
     std::vector<unsigned char> uc_vec = signature.toBytes();
     return uc_vec;
@@ -321,6 +418,7 @@ public:
     switch (keyType)
     {
     case KeyType::ECDSA:
+    case KeyType::EDDSA:
     {
       act_uc_vec = Helper::hexStringToByte(publicKey);
       break;
@@ -346,7 +444,9 @@ public:
     {
     case KeyType::ECDSA:
     case KeyType::SM2:
-      act_uc_vec = Helper::hexStringToByte(publicKey);
+    case KeyType::EDDSA:
+      // the scalar zero padded to the group order, or the Ed25519 seed
+      act_uc_vec = Helper::hexStringToByte(ecKey.getPrivateKeyHex());
       break;
     default:
       throw std::runtime_error(ErrorCode::StrUnknownKeyType);
@@ -356,9 +456,43 @@ public:
 
   std::string serializePublicKey_str() const { return publicKey; }
 
+  // msg is the digest generateSignature was given, every signature must
+  // verify against this account's public key
   bool verifySignature(std::vector<unsigned char> msg,
                        std::vector<Signature> signature)
   {
+    if (signature.empty())
+    {
+      return false;
+    }
+    ECKey key = ecKey;
+    if (key.empty())
+    {
+      key = ECKey::fromPublicKeyHex(
+          keyType == KeyType::EDDSA ? publicKey.substr(4) : publicKey,
+          curveName);
+    }
+    for (size_t i = 0; i < signature.size(); i++)
+    {
+      if (signature[i].getScheme() != signatureScheme)
+      {
+        return false;
+      }
+      std::vector<unsigned char> value = signature[i].getValue();
+      if (value.size() % 2 != 0)
+      {
+        value.erase(value.begin());
+      }
+      bool valid =
+          keyType == KeyType::EDDSA
+              ? SignatureHandler::EDDSA_verify(key, msg.data(), msg.size(),
+                                               value)
+              : SignatureHandler::ECDSA_verify_digest(key, msg, value);
+      if (!valid)
+      {
+        return false;
+      }
+    }
     return true;
   }
 
@@ -380,23 +514,33 @@ public:
                                        const std::vector<unsigned char> &salt,
                                        const int n)
   {
-    int r = 8;
-    int p = 8;
-    int dkLen = 64;
     if (salt.size() != 16)
     {
       throw new SDKException(ErrorCode::ParamError);
     }
-    std::vector<unsigned char> derivedkey;
-    derivedkey = ScryptHandler::scrypt(password, salt, n, r, p, dkLen);
-    std::vector<unsigned char> aes_iv(derivedkey.begin(),
-                                      derivedkey.begin() + 12);
-    std::vector<unsigned char> aes_key(derivedkey.begin() + 32,
-                                       derivedkey.begin() + 64);
-    // AES/GCM/NoPadding
-    std::vector<unsigned char> encryptedkey =
-        AES::gcmEncrypt(serializePrivateKey(), aes_key, aes_iv, false);
-    return Helper::base64Encode(encryptedkey, false);
+    std::vector<unsigned char> derivedkey =
+        ScryptHandler::scrypt(password, salt, n, 8, 8, 64);
+    std::string encrypted = exportGcmEncryptedPrikey(derivedkey);
+    OPENSSL_cleanse(derivedkey.data(), derivedkey.size());
+    return encrypted;
+  }
+
+  // exportGcmEncryptedPrikey with the scrypt derivation run on pool
+  std::future<std::string>
+  exportGcmEncryptedPrikeyAsync(ScryptPool &pool, const std::string &password,
+                                const std::vector<unsigned char> &salt,
+                                const int n)
+  {
+    if (salt.size() != 16)
+    {
+      throw new SDKException(ErrorCode::ParamError);
+    }
+    Account account = *this;
+    return pool.derive(ScryptPool::Job(password, salt, n, 8, 8, 64),
+                       [account](std::vector<unsigned char> &derivedkey) {
+                         Account copy = account;
+                         return copy.exportGcmEncryptedPrikey(derivedkey);
+                       });
   }
 
   static std::string getGcmDecodedPrivateKey(
@@ -404,46 +548,95 @@ public:
       std::string address, const std::vector<unsigned char> &salt, int n,
       SignatureScheme scheme)
   {
-    if (encryptedPriKey.length() == 0)
+    checkGcmEncryptedPrikey(encryptedPriKey, salt);
+    std::vector<unsigned char> derivedkey =
+        ScryptHandler::scrypt(password, salt, n, 8, 8, 64);
+    std::string prikey = getGcmDecodedPrivateKey(encryptedPriKey, address,
+                                                 derivedkey, scheme);
+    OPENSSL_cleanse(derivedkey.data(), derivedkey.size());
+    return prikey;
+  }
+
+  // getGcmDecodedPrivateKey with the scrypt derivation run on pool, so a
+  // wallet's accounts unlock in parallel
+  static std::future<std::string> getGcmDecodedPrivateKeyAsync(
+      ScryptPool &pool, const std::string &encryptedPriKey,
+      const std::string &password, const std::string &address,
+      const std::vector<unsigned char> &salt, int n, SignatureScheme scheme)
+  {
+    checkGcmEncryptedPrikey(encryptedPriKey, salt);
+    return pool.derive(
+        ScryptPool::Job(password, salt, n, 8, 8, 64),
+        [encryptedPriKey, address, scheme](
+            std::vector<unsigned char> &derivedkey) {
+          return getGcmDecodedPrivateKey(encryptedPriKey, address, derivedkey,
+                                         scheme);
+        });
+  }
+
+  // the AES half of exportGcmEncryptedPrikey, given the 64 byte scrypt
+  // key, for callers that keep derived keys around
+  std::string
+  exportGcmEncryptedPrikey(const std::vector<unsigned char> &derivedkey)
+  {
+    if (derivedkey.size() < 64)
     {
-      throw new SDKException(ErrorCode::EncryptedPriKeyError);
+      throw new SDKException(ErrorCode::ParamError);
     }
-    if (salt.size() != 16)
+    std::vector<unsigned char> aes_iv(derivedkey.begin(),
+                                      derivedkey.begin() + 12);
+    std::vector<unsigned char> aes_key(derivedkey.begin() + 32,
+                                       derivedkey.begin() + 64);
+    // AES/GCM/NoPadding, authenticated with the base58 address
+    std::string address = addressU160.toBase58();
+    std::vector<unsigned char> prikey = serializePrivateKey();
+    std::vector<unsigned char> encryptedkey = AES::gcmEncrypt(
+        prikey, aes_key, aes_iv, false,
+        std::vector<unsigned char>(address.begin(), address.end()));
+    OPENSSL_cleanse(prikey.data(), prikey.size());
+    OPENSSL_cleanse(aes_key.data(), aes_key.size());
+    return Helper::base64Encode(encryptedkey, false);
+  }
+
+  // the AES half of getGcmDecodedPrivateKey, given the 64 byte scrypt key
+  static std::string
+  getGcmDecodedPrivateKey(const std::string &encryptedPriKey,
+                          const std::string &address,
+                          const std::vector<unsigned char> &derivedkey,
+                          SignatureScheme scheme)
+  {
+    if (derivedkey.size() < 64)
     {
       throw new SDKException(ErrorCode::ParamError);
     }
-    // AES/GCM/NoPadding
-    std::string encryptedkey = Helper::base64Decode(encryptedPriKey, false);
-    int r = 8;
-    int p = 8;
-    int dkLen = 64;
-    std::vector<unsigned char> derivedkey;
-    derivedkey = ScryptHandler::scrypt(password, salt, n, r, p, dkLen);
+    // AES/GCM/NoPadding, authenticated with the base58 address
+    std::vector<unsigned char> encryptedkey =
+        Helper::base64DecodeBytes(encryptedPriKey, false);
     std::vector<unsigned char> aes_iv(derivedkey.begin(),
                                       derivedkey.begin() + 12);
     std::vector<unsigned char> aes_key(derivedkey.begin() + 32,
                                        derivedkey.begin() + 64);
-
     std::vector<unsigned char> rawkey;
-    //    try
-    //    {
-    //      SecretKeySpec skeySpec = new SecretKeySpec(derivedhalf2, "AES");
-    //      Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding");
-    //      cipher.init(Cipher.DECRYPT_MODE, skeySpec, new GCMParameterSpec(128, iv));
-    //      cipher.updateAAD(address.getBytes());
-    //      rawkey = cipher.doFinal(encryptedkey);
-    //    }
-    //    catch (Exception e)
-    //    {
-    //      e.printStackTrace();
-    //      throw new SDKException(ErrorCode.encryptedPriKeyAddressPasswordErr);
-    //    }
-    //    Account account = new Account(rawkey, scheme);
-    //    if (!address.equals(account.getAddressU160().toBase58()))
-    //    {
-    //      throw new SDKException(ErrorCode::encryptedPriKeyAddressPasswordErr);
-    //    }
-    return Helper::toHexString(rawkey);
+    try
+    {
+      rawkey = AES::gcmDecrypt(
+          encryptedkey, aes_key, aes_iv, false,
+          std::vector<unsigned char>(address.begin(), address.end()));
+    }
+    catch (const std::runtime_error &)
+    {
+      OPENSSL_cleanse(aes_key.data(), aes_key.size());
+      throw new SDKException(ErrorCode::encryptedPriKeyAddressPasswordErr);
+    }
+    OPENSSL_cleanse(aes_key.data(), aes_key.size());
+    std::string prikey = Helper::toHexString(rawkey.data(), rawkey.size());
+    OPENSSL_cleanse(rawkey.data(), rawkey.size());
+    Account account(prikey, scheme);
+    if (address != account.getAddressU160().toBase58())
+    {
+      throw new SDKException(ErrorCode::encryptedPriKeyAddressPasswordErr);
+    }
+    return "0x" + prikey;
   }
 
   //std::string exportCtrEncryptedPrikey(std::string passphrase, int n) {
@@ -0,0 +1,310 @@
+#ifndef ACCOUNT_ACCOUNTGENERATOR_H
+#define ACCOUNT_ACCOUNTGENERATOR_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include "../common/Address.h"
+#include "../common/Hex.h"
+#include "../common/ThreadPool.h"
+#include "../crypto/Curve.h"
+#include "../crypto/CurveRegistry.h"
+#include "../crypto/Digest.h"
+#include "../crypto/KeyType.hpp"
+#include "../crypto/SignatureScheme.h"
+
+// One freshly generated account, in the forms Account exposes:
+// getPrivateKeyHex-style lowercase hex, serializePublicKey_str() and the
+// base58 address. Account(privateKey, scheme) rebuilds it.
+struct GeneratedAccount
+{
+  std::string privateKey;
+  std::string publicKey;
+  std::string address;
+};
+
+// Bulk account generation for provisioning deposit addresses. Every
+// worker keeps its own BN_CTX, EC_POINT and random buffer for the whole
+// run, draws private keys from OpenSSL's per-thread DRBG a chunk at a
+// time and derives the public key straight on the shared precomputed
+// group. The address is hashed from the verification script bytes
+// without going through ScriptBuilder or an Account.
+class AccountGenerator
+{
+public:
+  // called with one account at a time, never concurrently; the private
+  // key string is wiped once the call returns
+  typedef std::function<void(const GeneratedAccount &)> Sink;
+
+  static const size_t CHUNK_SIZE = 256;
+
+private:
+  static const size_t KEY_SIZE = 32;
+
+  typedef std::unique_ptr<BN_CTX, void (*)(BN_CTX *)> BnCtxPtr;
+  typedef std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> BigNumPtr;
+  typedef std::unique_ptr<EC_POINT, void (*)(EC_POINT *)> PointPtr;
+
+  // the state a worker reuses for every key it makes
+  struct Worker
+  {
+    SignatureScheme scheme;
+    const EC_GROUP *group;
+    const BIGNUM *order;
+    BnCtxPtr bnCtx;
+    BigNumPtr scalar;
+    PointPtr point;
+    std::vector<unsigned char> random;
+
+    explicit Worker(SignatureScheme _scheme)
+        : scheme(_scheme), group(NULL), order(NULL), bnCtx(NULL, BN_CTX_free),
+          scalar(NULL, BN_clear_free), point(NULL, EC_POINT_free),
+          random(CHUNK_SIZE * KEY_SIZE)
+    {
+      if (scheme == SignatureScheme::SHA512withEDDSA)
+      {
+        return;
+      }
+      group = CurveRegistry::group(CurveName::p256);
+      order = EC_GROUP_get0_order(group);
+      bnCtx.reset(BN_CTX_secure_new());
+      scalar.reset(BN_secure_new());
+      point.reset(EC_POINT_new(group));
+      if (!bnCtx || !scalar || !point)
+      {
+        throw std::runtime_error("AccountGenerator: out of memory");
+      }
+    }
+
+    ~Worker() { OPENSSL_cleanse(random.data(), random.size()); }
+
+    void fillRandom()
+    {
+      if (RAND_priv_bytes(random.data(), (int)random.size()) != 1)
+      {
+        throw std::runtime_error("RAND_priv_bytes() fail.");
+      }
+    }
+
+    // false when seed is not a valid P-256 scalar, the caller draws again
+    bool makeEcdsa(const unsigned char *seed, GeneratedAccount &account)
+    {
+      if (BN_bin2bn(seed, KEY_SIZE, scalar.get()) == NULL)
+      {
+        throw std::runtime_error("BN_bin2bn() fail.");
+      }
+      if (BN_is_zero(scalar.get()) || BN_cmp(scalar.get(), order) >= 0)
+      {
+        return false;
+      }
+      unsigned char pub[33];
+      if (EC_POINT_mul(group, point.get(), scalar.get(), NULL, NULL,
+                       bnCtx.get()) != 1 ||
+          EC_POINT_point2oct(group, point.get(), POINT_CONVERSION_COMPRESSED,
+                             pub, sizeof(pub), bnCtx.get()) != sizeof(pub))
+      {
+        throw std::runtime_error("EC_POINT_mul() fail.");
+      }
+      account.privateKey = hex(seed, KEY_SIZE);
+      // EC_POINT_point2hex case, as ECKey::getPublicKeyHex returns it
+      account.publicKey = hex(pub, sizeof(pub));
+      for (size_t i = 0; i < account.publicKey.size(); i++)
+      {
+        account.publicKey[i] = (char)toupper(account.publicKey[i]);
+      }
+      account.address = address(pub, sizeof(pub));
+      return true;
+    }
+
+    void makeEddsa(const unsigned char *seed, GeneratedAccount &account)
+    {
+      std::unique_ptr<EVP_PKEY, void (*)(EVP_PKEY *)> pkey(
+          EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, seed,
+                                       KEY_SIZE),
+          EVP_PKEY_free);
+      // label || curve label || key, as Account serializes it
+      unsigned char pub[2 + KEY_SIZE];
+      pub[0] = (unsigned char)KeyTypeMethod::getLabel(KeyType::EDDSA);
+      pub[1] = (unsigned char)CurveNameMethod::getLabel(CurveName::ED25519);
+      size_t len = KEY_SIZE;
+      if (!pkey ||
+          EVP_PKEY_get_raw_public_key(pkey.get(), pub + 2, &len) != 1 ||
+          len != KEY_SIZE)
+      {
+        throw std::runtime_error("EVP_PKEY_get_raw_public_key() failed!");
+      }
+      account.privateKey = hex(seed, KEY_SIZE);
+      account.publicKey = hex(pub, sizeof(pub));
+      account.address = address(pub, sizeof(pub));
+    }
+
+    // fills accounts with count new ones
+    void generate(std::vector<GeneratedAccount> &accounts, size_t count)
+    {
+      accounts.resize(count);
+      size_t made = 0;
+      while (made < count)
+      {
+        fillRandom();
+        for (size_t i = 0; i < CHUNK_SIZE && made < count; i++)
+        {
+          const unsigned char *seed = random.data() + i * KEY_SIZE;
+          if (scheme == SignatureScheme::SHA512withEDDSA)
+          {
+            makeEddsa(seed, accounts[made++]);
+          }
+          else if (makeEcdsa(seed, accounts[made]))
+          {
+            made++;
+          }
+        }
+      }
+    }
+  };
+
+  static std::string hex(const unsigned char *data, size_t len)
+  {
+    std::string str(2 * len, '0');
+    Hex::encode(data, len, &str[0]);
+    return str;
+  }
+
+  // base58 of hash160(PUSH(pub) || OP_CHECKSIG), what
+  // Address::addressFromPubKey builds through ScriptBuilder
+  static std::string address(const unsigned char *pub, size_t len)
+  {
+    unsigned char script[1 + 34 + 1];
+    script[0] = (unsigned char)len;
+    memcpy(script + 1, pub, len);
+    script[1 + len] = 0xAC;
+    Digest::Hash160 hash = Digest::hash160(script, len + 2);
+    return Address(std::vector<unsigned char>(hash.begin(), hash.end()))
+        .toBase58();
+  }
+
+  // a worker's chunk, private keys wiped however the worker exits
+  struct Chunk
+  {
+    std::vector<GeneratedAccount> accounts;
+
+    void wipe()
+    {
+      for (size_t i = 0; i < accounts.size(); i++)
+      {
+        std::string &key = accounts[i].privateKey;
+        if (!key.empty())
+        {
+          OPENSSL_cleanse(&key[0], key.size());
+        }
+      }
+    }
+
+    ~Chunk() { wipe(); }
+  };
+
+public:
+  // Generates count accounts on threads workers (0 for one per hardware
+  // thread) and hands each to sink as soon as its chunk is done. Accounts
+  // arrive in no particular order. The first exception, from key
+  // generation or from sink, stops the other workers after their current
+  // chunk and is rethrown here.
+  static void
+  generateAccounts(size_t count, size_t threads, const Sink &sink,
+                   SignatureScheme scheme = SignatureScheme::SHA256withECDSA)
+  {
+    if (scheme != SignatureScheme::SHA256withECDSA &&
+        scheme != SignatureScheme::SHA512withEDDSA)
+    {
+      throw std::runtime_error("SignatureScheme Unsupport");
+    }
+    if (count == 0)
+    {
+      return;
+    }
+    ThreadPool pool(threads);
+    size_t workers =
+        std::min(pool.size(), (count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex sinkMutex;
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers);
+    for (size_t w = 0; w < workers; w++)
+    {
+      futures.push_back(pool.submit([&]() {
+        try
+        {
+          Worker worker(scheme);
+          Chunk chunk;
+          while (!failed)
+          {
+            size_t begin = next.fetch_add(CHUNK_SIZE);
+            if (begin >= count)
+            {
+              break;
+            }
+            size_t left = count - begin;
+            worker.generate(chunk.accounts,
+                            left < CHUNK_SIZE ? left : CHUNK_SIZE);
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            for (size_t i = 0; i < chunk.accounts.size() && !failed; i++)
+            {
+              sink(chunk.accounts[i]);
+            }
+            chunk.wipe();
+          }
+        }
+        catch (...)
+        {
+          failed = true;
+          throw;
+        }
+      }));
+    }
+    // every worker must finish before the shared state goes away
+    for (size_t w = 0; w < futures.size(); w++)
+    {
+      futures[w].wait();
+    }
+    for (size_t w = 0; w < futures.size(); w++)
+    {
+      futures[w].get();
+    }
+  }
+
+  static std::vector<GeneratedAccount>
+  generateAccounts(size_t count, size_t threads = 0,
+                   SignatureScheme scheme = SignatureScheme::SHA256withECDSA)
+  {
+    std::vector<GeneratedAccount> accounts;
+    accounts.reserve(count);
+    generateAccounts(
+        count, threads,
+        [&accounts](const GeneratedAccount &account) {
+          accounts.push_back(account);
+        },
+        scheme);
+    return accounts;
+  }
+};
+
+#endif
@@ -91,11 +91,10 @@ public:
     return address;
   }
 
-  // void deserialize(BinaryReader &reader) {
-  //   std::string str;
-  //   str = reader.readVarBytes();
-  //   memcpy(ZERO, (unsigned char *)str.c_str(), 20);
-  // }
+  void deserialize(BinaryReader *reader)
+  {
+    set_data_bytes(reader->readBytes_vec(zero_size));
+  }
 
   std::string toHexString()
   {
@@ -107,11 +106,12 @@ public:
   addressFromPubKey(const std::vector<unsigned char> &publicKey)
   {
     ScriptBuilder builder;
-    if (publicKey.size() == 33)
+    // a compressed EC point, or label || curve label || key for EdDSA
+    if (publicKey.size() == 33 || publicKey.size() == 34)
     {
       builder.push(publicKey);
     }
-    else if (publicKey.size() == 66)
+    else if (publicKey.size() == 66 || publicKey.size() == 68)
     {
       builder.push(Helper::hexVecToByte(publicKey));
     }
@@ -205,11 +205,10 @@ public:
     return toScriptHash(Program::ProgramFromMultiPubKey(m, publicKeys));
   }
 
-  static Address decodeBase58(std::string address)
+  static Address decodeBase58(const std::string &address)
   {
-    std::vector<unsigned char> data;
-    Helper::DecodeBase58(address, data);
-    if (data.size() != 25)
+    unsigned char data[Base58::ADDRESS_SIZE];
+    if (!Base58::decodeAddress(address.data(), address.size(), data))
     {
       throw "SDKException(ErrorCode.ParamError)";
     }
@@ -217,33 +216,69 @@ public:
     {
       throw "SDKException(ErrorCode.ParamError)";
     }
-    std::vector<unsigned char> checksum;
-    checksum = Digest::sha256(Digest::sha256(data, 0, 21));
-    for (int i = 0; i < 4; i++)
+    unsigned char checksum[4];
+    base58Checksum(data, checksum);
+    if (memcmp(data + 21, checksum, 4) != 0)
+    {
+      throw "SDKException(ErrorCode.ParamError)";
+    }
+    return Address(std::vector<unsigned char>(data + 1, data + 21));
+  }
+
+  std::string toBase58() const
+  {
+    char str[Base58::MAX_ADDRESS_LENGTH];
+    return std::string(str, toBase58(str));
+  }
+
+  // batch forms for indexing and reconciliation, the per address work is
+  // all on the stack apart from the results themselves
+  static std::vector<std::string>
+  toBase58(const std::vector<Address> &addresses)
+  {
+    std::vector<std::string> ret;
+    ret.reserve(addresses.size());
+    char str[Base58::MAX_ADDRESS_LENGTH];
+    for (size_t i = 0; i < addresses.size(); i++)
     {
-      if (data[data.size() - 4 + i] != checksum[i])
-      {
-        throw "SDKException(ErrorCode.ParamError)";
-      }
+      ret.push_back(std::string(str, addresses[i].toBase58(str)));
+    }
+    return ret;
+  }
+
+  static std::vector<Address>
+  decodeBase58(const std::vector<std::string> &addresses)
+  {
+    std::vector<Address> ret;
+    ret.reserve(addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+      ret.push_back(decodeBase58(addresses[i]));
+    }
+    return ret;
+  }
+
+private:
+  // first 4 bytes of sha256(sha256(version || hash))
+  static void base58Checksum(const unsigned char *payload,
+                             unsigned char *checksum)
+  {
+    Digest::Hash256 hash = Digest::hash256(payload, 21);
+    memcpy(checksum, hash.data(), 4);
+  }
+
+  size_t toBase58(char *str) const
+  {
+    const std::vector<unsigned char> &value = bytes();
+    if (value.size() < 20)
+    {
+      throw std::runtime_error("IllegalArgumentException");
     }
-    std::vector<unsigned char> buffer;
-    buffer.assign(data.begin() + 1, data.begin() + 21);
-    return Address(buffer);
-  }
-
-  std::string toBase58()
-  {
-    std::vector<unsigned char> data;
-    data.push_back(COIN_VERSION);
-    std::vector<unsigned char> data_bytes;
-    data_bytes = toArray();
-    data.insert(data.end(), data_bytes.begin(), data_bytes.begin() + 20);
-    std::vector<unsigned char> checksum;
-    checksum = Digest::sha256(Digest::sha256(data, 0, 21));
-    data.insert(data.end(), checksum.begin(), checksum.begin() + 4);
-    std::string str;
-    str = Helper::EncodeBase58(data);
-    return str;
+    unsigned char data[Base58::ADDRESS_SIZE];
+    data[0] = COIN_VERSION;
+    memcpy(data + 1, value.data(), 20);
+    base58Checksum(data, data + 21);
+    return Base58::encodeAddress(data, str);
   }
 };
 
@@ -0,0 +1,213 @@
+#ifndef BASE58_H
+#define BASE58_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/** All alphanumeric characters except for "0", "I", "O", and "l" */
+static const char *pszBase58 =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static const int8_t mapBase58[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0,  1,  2,  3,  4,  5,  6,  7,
+    8,  -1, -1, -1, -1, -1, -1, -1, 9,  10, 11, 12, 13, 14, 15, 16, -1, 17, 18,
+    19, 20, 21, -1, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1,
+    -1, -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46, 47, 48,
+    49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+// Base58 on 32-bit limbs. The encoder accumulates the input four bytes at a
+// time into limbs of base 58^5 and the decoder accumulates five digits at a
+// time into limbs of base 2^32, so a 25-byte address costs about 50 64-bit
+// mul/div steps instead of one division per output digit per input byte.
+class Base58 {
+private:
+  // 58^5
+  static const uint32_t LIMB_BASE = 656356768;
+
+  static size_t encodeLimbs(size_t len) { return (len * 138 / 100 + 1) / 5 + 2; }
+
+  static size_t decodeLimbs(size_t len) { return (len * 733 / 1000 + 1) / 4 + 1; }
+
+  // limbs is scratch for encodeLimbs(len) words, out has room for
+  // maxEncodedSize(len) chars
+  static size_t encode(const unsigned char *in, size_t len, uint32_t *limbs,
+                       char *out) {
+    size_t zeroes = 0;
+    while (zeroes < len && in[zeroes] == 0) {
+      zeroes++;
+    }
+    in += zeroes;
+    len -= zeroes;
+    size_t used = 0;
+    for (size_t i = 0; i < len;) {
+      // the most significant word takes the odd bytes
+      size_t n = (i == 0 && len % 4 != 0) ? len % 4 : 4;
+      uint64_t carry = 0;
+      for (size_t k = 0; k < n; k++) {
+        carry = (carry << 8) | in[i + k];
+      }
+      i += n;
+      // limbs = limbs * 2^32 + carry
+      for (size_t j = 0; j < used; j++) {
+        uint64_t t = ((uint64_t)limbs[j] << 32) + carry;
+        limbs[j] = (uint32_t)(t % LIMB_BASE);
+        carry = t / LIMB_BASE;
+      }
+      while (carry != 0) {
+        limbs[used++] = (uint32_t)(carry % LIMB_BASE);
+        carry /= LIMB_BASE;
+      }
+    }
+    char *p = out;
+    memset(p, '1', zeroes);
+    p += zeroes;
+    if (used == 0) {
+      return p - out;
+    }
+    // no leading '1' for the top limb, five digits for every other one
+    char top[5];
+    int top_len = 0;
+    for (uint32_t v = limbs[used - 1]; v != 0; v /= 58) {
+      top[top_len++] = pszBase58[v % 58];
+    }
+    while (top_len > 0) {
+      *p++ = top[--top_len];
+    }
+    for (size_t j = used - 1; j-- > 0;) {
+      uint32_t v = limbs[j];
+      for (int k = 4; k >= 0; k--) {
+        p[k] = pszBase58[v % 58];
+        v /= 58;
+      }
+      p += 5;
+    }
+    return p - out;
+  }
+
+  // fails on a non base58 char or when the value does not fit into cap bytes
+  static bool decode(const char *in, size_t len, uint32_t *limbs,
+                     size_t max_limbs, unsigned char *out, size_t cap,
+                     size_t &out_len) {
+    size_t zeroes = 0;
+    while (zeroes < len && in[zeroes] == '1') {
+      zeroes++;
+    }
+    in += zeroes;
+    len -= zeroes;
+    size_t used = 0;
+    for (size_t i = 0; i < len;) {
+      // the most significant chunk takes the odd digits
+      size_t n = (i == 0 && len % 5 != 0) ? len % 5 : 5;
+      uint64_t carry = 0;
+      uint32_t mult = 1;
+      for (size_t k = 0; k < n; k++) {
+        int8_t d = mapBase58[(uint8_t)in[i + k]];
+        if (d < 0) {
+          return false;
+        }
+        carry = carry * 58 + d;
+        mult *= 58;
+      }
+      i += n;
+      // limbs = limbs * 58^n + carry
+      for (size_t j = 0; j < used; j++) {
+        uint64_t t = (uint64_t)limbs[j] * mult + carry;
+        limbs[j] = (uint32_t)t;
+        carry = t >> 32;
+      }
+      if (carry != 0) {
+        if (used == max_limbs) {
+          return false;
+        }
+        limbs[used++] = (uint32_t)carry;
+      }
+    }
+    size_t top_len = 0;
+    if (used != 0) {
+      for (uint32_t v = limbs[used - 1]; v != 0; v >>= 8) {
+        top_len++;
+      }
+    }
+    size_t value_len = used == 0 ? 0 : top_len + 4 * (used - 1);
+    if (zeroes + value_len > cap) {
+      return false;
+    }
+    unsigned char *p = out;
+    memset(p, 0, zeroes);
+    p += zeroes;
+    for (size_t j = used; j-- > 0;) {
+      for (size_t k = (j == used - 1 ? top_len : 4); k-- > 0;) {
+        *p++ = (unsigned char)(limbs[j] >> (8 * k));
+      }
+    }
+    out_len = p - out;
+    return true;
+  }
+
+public:
+  // version byte, 20-byte script hash and 4 checksum bytes
+  static const size_t ADDRESS_SIZE = 25;
+  static const size_t MAX_ADDRESS_LENGTH = 35;
+
+  static size_t maxEncodedSize(size_t len) { return len * 138 / 100 + 1; }
+
+  static std::string encode(const unsigned char *data, size_t len) {
+    std::vector<uint32_t> limbs(encodeLimbs(len));
+    std::string str(maxEncodedSize(len), '\0');
+    str.resize(encode(data, len, limbs.data(), &str[0]));
+    return str;
+  }
+
+  static bool decode(const char *str, size_t len,
+                     std::vector<unsigned char> &out) {
+    size_t max_limbs = decodeLimbs(len);
+    std::vector<uint32_t> limbs(max_limbs);
+    // a leading '1' is one zero byte, any other digit is less than one byte
+    out.resize(len);
+    size_t out_len = 0;
+    if (!decode(str, len, limbs.data(), max_limbs, out.data(), out.size(),
+                out_len)) {
+      out.clear();
+      return false;
+    }
+    out.resize(out_len);
+    return true;
+  }
+
+  // writes at most MAX_ADDRESS_LENGTH chars and returns the count, the
+  // scratch space lives on the stack
+  static size_t encodeAddress(const unsigned char *payload, char *out) {
+    uint32_t limbs[(ADDRESS_SIZE * 138 / 100 + 1) / 5 + 2];
+    return encode(payload, ADDRESS_SIZE, limbs, out);
+  }
+
+  // true only if str decodes to exactly ADDRESS_SIZE bytes
+  static bool decodeAddress(const char *str, size_t len,
+                            unsigned char *payload) {
+    if (len > MAX_ADDRESS_LENGTH) {
+      return false;
+    }
+    uint32_t limbs[ADDRESS_SIZE / 4 + 1];
+    size_t out_len = 0;
+    return decode(str, len, limbs, ADDRESS_SIZE / 4 + 1, payload,
+                  ADDRESS_SIZE, out_len) &&
+           out_len == ADDRESS_SIZE;
+  }
+};
+
+#endif
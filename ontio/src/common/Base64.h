@@ -0,0 +1,180 @@
+#ifndef BASE64_H
+#define BASE64_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Standard alphabet Base64 with '=' padding. The decoder skips whitespace,
+// so line-wrapped input works, and translates 16 chars per step with SSE2
+// while the input has neither whitespace nor padding.
+class Base64 {
+private:
+  static const char *alphabet() {
+    return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  }
+
+  // -1 for chars outside the alphabet
+  static int8_t value(unsigned char c) {
+    static const int8_t map[256] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+        -1, 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+        -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    };
+    return map[c];
+  }
+
+  static bool isSpace(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+#if defined(__SSE2__) || defined(_M_X64)
+  // mask of the bytes in [lo, lo + span]
+  static __m128i inRange(__m128i c, char lo, char span, __m128i &offset) {
+    offset = _mm_sub_epi8(c, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(span)), offset);
+  }
+
+  // 16 chars -> 12 bytes, false if any char is not in the alphabet
+  static bool decode16(const char *src, unsigned char *dst) {
+    __m128i c = _mm_loadu_si128((const __m128i *)src);
+    __m128i upper_v, lower_v, digit_v;
+    __m128i upper = inRange(c, 'A', 25, upper_v);
+    __m128i lower = inRange(c, 'a', 25, lower_v);
+    __m128i digit = inRange(c, '0', 9, digit_v);
+    __m128i plus = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+    __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+    __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                 _mm_or_si128(_mm_or_si128(digit, plus), slash));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+      return false;
+    }
+    __m128i v = _mm_and_si128(upper, upper_v);
+    v = _mm_or_si128(
+        v, _mm_and_si128(lower, _mm_add_epi8(lower_v, _mm_set1_epi8(26))));
+    v = _mm_or_si128(
+        v, _mm_and_si128(digit, _mm_add_epi8(digit_v, _mm_set1_epi8(52))));
+    v = _mm_or_si128(v, _mm_and_si128(plus, _mm_set1_epi8(62)));
+    v = _mm_or_si128(v, _mm_and_si128(slash, _mm_set1_epi8(63)));
+    // four 6-bit values per 32-bit lane, the first one in the low byte
+    __m128i mask = _mm_set1_epi32(0x3F);
+    __m128i t = _mm_slli_epi32(_mm_and_si128(v, mask), 18);
+    t = _mm_or_si128(
+        t, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(v, 8), mask), 12));
+    t = _mm_or_si128(
+        t, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(v, 16), mask), 6));
+    t = _mm_or_si128(t, _mm_srli_epi32(v, 24));
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, t);
+    for (int k = 0; k < 4; k++) {
+      dst[3 * k] = (unsigned char)(lanes[k] >> 16);
+      dst[3 * k + 1] = (unsigned char)(lanes[k] >> 8);
+      dst[3 * k + 2] = (unsigned char)lanes[k];
+    }
+    return true;
+  }
+#endif
+
+public:
+  static size_t encodedSize(size_t len) { return (len + 2) / 3 * 4; }
+
+  // upper bound, whitespace and padding make the real size smaller
+  static size_t decodedMaxSize(size_t len) { return (len + 3) / 4 * 3; }
+
+  // writes encodedSize(len) chars, no terminator
+  static void encode(const unsigned char *src, size_t len, char *dst) {
+    const char *table = alphabet();
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+      uint32_t v = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) |
+                   src[i + 2];
+      dst[0] = table[v >> 18];
+      dst[1] = table[(v >> 12) & 0x3F];
+      dst[2] = table[(v >> 6) & 0x3F];
+      dst[3] = table[v & 0x3F];
+      dst += 4;
+    }
+    if (i < len) {
+      uint32_t v = (uint32_t)src[i] << 16;
+      if (i + 1 < len) {
+        v |= (uint32_t)src[i + 1] << 8;
+      }
+      dst[0] = table[v >> 18];
+      dst[1] = table[(v >> 12) & 0x3F];
+      dst[2] = i + 1 < len ? table[(v >> 6) & 0x3F] : '=';
+      dst[3] = '=';
+    }
+  }
+
+  // dst needs decodedMaxSize(len) bytes. Padding is optional, but once it
+  // starts only more padding and whitespace may follow.
+  static bool decode(const char *src, size_t len, unsigned char *dst,
+                     size_t &dst_len) {
+    unsigned char *p = dst;
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= len && decode16(src + i, p); i += 16) {
+      p += 12;
+    }
+#endif
+    uint32_t acc = 0;
+    int n = 0;
+    int pad = 0;
+    for (; i < len; i++) {
+      unsigned char c = (unsigned char)src[i];
+      if (isSpace(c)) {
+        continue;
+      }
+      if (c == '=') {
+        pad++;
+        continue;
+      }
+      int8_t v = value(c);
+      if (v < 0 || pad != 0) {
+        return false;
+      }
+      acc = (acc << 6) | (uint32_t)v;
+      if (++n == 4) {
+        p[0] = (unsigned char)(acc >> 16);
+        p[1] = (unsigned char)(acc >> 8);
+        p[2] = (unsigned char)acc;
+        p += 3;
+        acc = 0;
+        n = 0;
+      }
+    }
+    if (n == 1 || (pad != 0 && n + pad != 4)) {
+      return false;
+    }
+    if (n == 2) {
+      *p++ = (unsigned char)(acc >> 4);
+    } else if (n == 3) {
+      *p++ = (unsigned char)(acc >> 10);
+      *p++ = (unsigned char)(acc >> 2);
+    }
+    dst_len = p - dst;
+    return true;
+  }
+};
+
+#endif
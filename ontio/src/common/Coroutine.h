@@ -0,0 +1,241 @@
+#ifndef COMMON_COROUTINE_H
+#define COMMON_COROUTINE_H
+
+#if __cplusplus < 202002L
+#error "use --std=c++20 option for compile."
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "ThreadPool.h"
+
+// Where a coroutine continues once the I/O it awaited has finished.
+class CoExecutor
+{
+public:
+  virtual ~CoExecutor() {}
+  virtual void post(std::function<void()> work) = 0;
+};
+
+// Resumes right on the thread that completed the I/O, the network loop
+// for the SDK. Cheapest, but the coroutine must not block until its next
+// co_await, or it stalls every other request on that loop.
+class InlineExecutor : public CoExecutor
+{
+public:
+  void post(std::function<void()> work) override { work(); }
+};
+
+// Resumes on a pool of worker threads, for coroutines that do real work
+// (signing, parsing) between requests.
+class ThreadPoolExecutor : public CoExecutor
+{
+private:
+  ThreadPool pool;
+
+public:
+  // threads == 0 uses one worker per hardware thread
+  explicit ThreadPoolExecutor(size_t threads = 0) : pool(threads) {}
+
+  void post(std::function<void()> work) override { pool.submit(work); }
+};
+
+template <class T> class Task;
+
+namespace coroutine_detail
+{
+
+template <class T> struct TaskPromiseBase
+{
+  std::coroutine_handle<> continuation;
+  std::exception_ptr error;
+
+  struct FinalAwaiter
+  {
+    bool await_ready() noexcept { return false; }
+
+    template <class P>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<P> handle) noexcept
+    {
+      std::coroutine_handle<> next = handle.promise().continuation;
+      return next ? next : std::noop_coroutine();
+    }
+
+    void await_resume() noexcept {}
+  };
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  FinalAwaiter final_suspend() noexcept { return {}; }
+  void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <class T> struct TaskPromise : TaskPromiseBase<T>
+{
+  std::optional<T> value;
+
+  Task<T> get_return_object();
+
+  template <class U> void return_value(U &&result)
+  {
+    value.emplace(std::forward<U>(result));
+  }
+
+  T result()
+  {
+    if (this->error)
+    {
+      std::rethrow_exception(this->error);
+    }
+    return std::move(*value);
+  }
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase<void>
+{
+  Task<void> get_return_object();
+
+  void return_void() {}
+
+  void result()
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+// a coroutine that starts at once and frees itself when it ends
+struct Detached
+{
+  struct promise_type
+  {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+} // namespace coroutine_detail
+
+// A lazily started coroutine producing a T. It runs when it is first
+// co_awaited and resumes its awaiter when it finishes, rethrowing its
+// exception there. Move only.
+template <class T = void> class Task
+{
+public:
+  typedef coroutine_detail::TaskPromise<T> promise_type;
+
+private:
+  std::coroutine_handle<promise_type> handle;
+
+public:
+  explicit Task(std::coroutine_handle<promise_type> _handle) : handle(_handle)
+  {
+  }
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr))
+  {
+  }
+
+  Task &operator=(Task &&other) noexcept
+  {
+    if (this != &other)
+    {
+      if (handle)
+      {
+        handle.destroy();
+      }
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task()
+  {
+    if (handle)
+    {
+      handle.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  std::coroutine_handle<>
+  await_suspend(std::coroutine_handle<> awaiter) noexcept
+  {
+    handle.promise().continuation = awaiter;
+    return handle;
+  }
+
+  T await_resume() { return handle.promise().result(); }
+};
+
+namespace coroutine_detail
+{
+
+template <class T> Task<T> TaskPromise<T>::get_return_object()
+{
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+  return Task<void>(
+      std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+template <class T>
+Detached runInto(Task<T> task, std::shared_ptr<std::promise<T>> promise)
+{
+  try
+  {
+    if constexpr (std::is_void<T>::value)
+    {
+      co_await task;
+      promise->set_value();
+    }
+    else
+    {
+      promise->set_value(co_await task);
+    }
+  }
+  catch (...)
+  {
+    promise->set_exception(std::current_exception());
+  }
+}
+
+} // namespace coroutine_detail
+
+// Starts task on the calling thread and returns a future for its result,
+// the bridge from blocking code into coroutines.
+template <class T> std::future<T> spawn(Task<T> task)
+{
+  std::shared_ptr<std::promise<T>> promise =
+      std::make_shared<std::promise<T>>();
+  std::future<T> result = promise->get_future();
+  coroutine_detail::runInto(std::move(task), promise);
+  return result;
+}
+
+// spawn(task).get(): blocks the calling thread until task has finished
+template <class T> T syncWait(Task<T> task)
+{
+  return spawn(std::move(task)).get();
+}
+
+#endif
@@ -18,36 +18,18 @@
 
 #include <boost/any.hpp>
 #include <nlohmann/json.hpp>
-#include <openssl/bio.h>
 #include <openssl/bn.h>
-#include <openssl/buffer.h>
 #include <openssl/evp.h>
 
+#include "Base58.h"
+#include "Base64.h"
+#include "Hex.h"
+
 #if defined(WIN32) || defined(_WIN64)
 #pragma comment(lib, "libeay32.lib")
 #pragma comment(lib, "ssleay32.lib")
 #endif
 
-/** All alphanumeric characters except for "0", "I", "O", and "l" */
-static const char *pszBase58 =
-    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-static const int8_t mapBase58[256] = {
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0,  1,  2,  3,  4,  5,  6,  7,
-    8,  -1, -1, -1, -1, -1, -1, -1, 9,  10, 11, 12, 13, 14, 15, 16, -1, 17, 18,
-    19, 20, 21, -1, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1,
-    -1, -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46, 47, 48,
-    49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1,
-};
-
 class Helper {
 public:
   static std::vector<unsigned char>
@@ -65,39 +47,19 @@ public:
     return data3;
   }
 
-  static std::vector<unsigned char> hexStringToByte(std::string str) {
+  static std::vector<unsigned char> hexStringToByte(const std::string &str) {
     size_t str_sz = str.size();
     if (str_sz % 2 != 0) {
       throw std::runtime_error("hexStringToByte error");
     }
-    if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
-      str.assign(str, 2, str.size() - 2);
+    const char *hex = str.data();
+    if (str_sz >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+      hex += 2;
       str_sz -= 2;
     }
-    std::vector<unsigned char> byte_vec;
-    for (size_t i = 0; i < str_sz; i += 2) {
-      unsigned char uch;
-      if ('a' <= str[i] && str[i] <= 'z') {
-        uch = ((str[i] - 'a' + 10) << 4) & 0xF0;
-      } else if ('A' <= str[i] && str[i] <= 'Z') {
-        uch = ((str[i] - 'A' + 10) << 4) & 0xF0;
-      } else if ('0' <= str[i] && str[i] <= '9') {
-        uch = ((str[i] - '0') << 4) & 0xF0;
-      } else {
-        throw std::runtime_error("string isn't hexString.");
-      }
-      unsigned char ucl;
-      if ('a' <= str[i + 1] && str[i + 1] <= 'z') {
-        ucl = (str[i + 1] - 'a' + 10) & 0x0F;
-      } else if ('A' <= str[i + 1] && str[i + 1] <= 'Z') {
-        ucl = (str[i + 1] - 'A' + 10) & 0x0F;
-      } else if ('0' <= str[i + 1] && str[i + 1] <= '9') {
-        ucl = (str[i + 1] - '0') & 0x0F;
-      } else {
-        throw std::runtime_error("string isn't hexString.");
-      }
-      unsigned char uc = uch | ucl;
-      byte_vec.push_back(uc);
+    std::vector<unsigned char> byte_vec(str_sz / 2);
+    if (!Hex::decode(hex, byte_vec.size(), byte_vec.data())) {
+      throw std::runtime_error("string isn't hexString.");
     }
     return byte_vec;
   }
@@ -108,77 +70,44 @@ public:
     if (vec_sz % 2 != 0) {
       throw "hexStringToByte error";
     }
-    std::vector<unsigned char> byte_vec;
-    for (size_t i = 0; i < vec_sz; i += 2) {
-      unsigned char uch;
-      if ('a' <= vec[i] && vec[i] <= 'f') {
-        uch = ((vec[i] - 'a' + 10) << 4) & 0xF0;
-      } else if ('A' <= vec[i] && vec[i] <= 'F') {
-        uch = ((vec[i] - 'A' + 10) << 4) & 0xF0;
-      } else if ('0' <= vec[i] && vec[i] <= '9') {
-        uch = ((vec[i] - '0') << 4) & 0xF0;
-      } else {
-        throw "unsigned char isn't hex!";
-      }
-      unsigned char ucl;
-      if ('a' <= vec[i + 1] && vec[i + 1] <= 'f') {
-        ucl = (vec[i + 1] - 'a' + 10) & 0x0F;
-      } else if ('A' <= vec[i + 1] && vec[i + 1] <= 'F') {
-        ucl = (vec[i + 1] - 'A' + 10) & 0x0F;
-      } else if ('0' <= vec[i + 1] && vec[i + 1] <= '9') {
-        ucl = (vec[i + 1] - '0') & 0x0F;
-      } else {
-        throw "unsigned char isn't hex!";
-      }
-      unsigned char uc = uch | ucl;
-      byte_vec.push_back(uc);
+    std::vector<unsigned char> byte_vec(vec_sz / 2);
+    if (!Hex::decode((const char *)vec.data(), byte_vec.size(),
+                     byte_vec.data())) {
+      throw "unsigned char isn't hex!";
     }
     return byte_vec;
   }
 
   static std::string toHexString(const std::vector<unsigned char> &value) {
-    std::string hex_str;
-    std::vector<unsigned char>::const_iterator value_cit;
-    std::stringstream stream;
-    stream << "0x";
-    for (value_cit = value.cbegin(); value_cit != value.cend(); value_cit++) {
-      stream << std::setfill('0') << std::setw(sizeof(unsigned char) * 2)
-             << std::hex << (unsigned int)*value_cit;
-    }
-    std::string str = stream.str();
+    std::string str(2 + value.size() * 2, '0');
+    str[1] = 'x';
+    Hex::encode(value.data(), value.size(), &str[2]);
     return str;
   }
 
-  static std::string toHexString(unsigned char *data, int len) {
-    char hexmap[] = {'0', '1', '2', '3', '4', '5', '6', '7',
-                     '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+  static std::string toHexString(const unsigned char *data, size_t len) {
     std::string s(len * 2, ' ');
-    for (int i = 0; i < len; ++i) {
-      s[2 * i] = hexmap[(data[i] & 0xF0) >> 4];
-      s[2 * i + 1] = hexmap[data[i] & 0x0F];
-    }
+    Hex::encode(data, len, &s[0]);
     return s;
   }
 
-  static std::vector<unsigned char> hexToBytes(std::string value) {
+  static std::vector<unsigned char> hexToBytes(const std::string &value) {
     std::vector<unsigned char> ret_vec;
     if (value.empty()) {
       return ret_vec;
     }
-    int len = value.length();
+    size_t len = value.length();
     if (len % 2 == 1) {
       throw std::runtime_error("IllegalArgumentException");
     }
-    size_t i = 0;
-    while (i < value.size()) {
-      i += 2;
-      value.insert(i, 1, ' ');
-      i += 1;
+    const char *hex = value.data();
+    if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+      hex += 2;
+      len -= 2;
     }
-    std::istringstream hex_chars_stream(value);
-    unsigned int c;
-    while (hex_chars_stream >> std::hex >> c) {
-      ret_vec.push_back(c);
+    ret_vec.resize(len / 2);
+    if (!Hex::decode(hex, ret_vec.size(), ret_vec.data())) {
+      throw std::runtime_error("IllegalArgumentException");
     }
     return ret_vec;
   }
@@ -194,93 +123,21 @@ public:
     // Skip leading spaces.
     while (*psz && isspace(*psz))
       psz++;
-    // Skip and count leading '1's.
-    int zeroes = 0;
-    int length = 0;
-    while (*psz == '1') {
-      zeroes++;
-      psz++;
-    }
-    // Allocate enough space in big-endian base256 representation.
-    int size = strlen(psz) * 733 / 1000 + 1; // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(size);
-    // Process the characters.
-    static_assert(
-        sizeof(mapBase58) / sizeof(mapBase58[0]) == 256,
-        "mapBase58.size() should be 256"); // guarantee not out of range
-    while (*psz && !isspace(*psz)) {
-      // Decode base58 character
-      int carry = mapBase58[(uint8_t)*psz];
-      if (carry == -1) // Invalid b58 character
-        return false;
-      int i = 0;
-      for (std::vector<unsigned char>::reverse_iterator it = b256.rbegin();
-           (carry != 0 || i < length) && (it != b256.rend()); ++it, ++i) {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
-      }
-      assert(carry == 0);
-      length = i;
-      psz++;
-    }
+    const char *end = psz;
+    while (*end && !isspace(*end))
+      end++;
     // Skip trailing spaces.
-    while (isspace(*psz))
-      psz++;
-    if (*psz != 0)
+    const char *tail = end;
+    while (isspace(*tail))
+      tail++;
+    if (*tail != 0)
       return false;
-    // Skip leading zeroes in b256.
-    std::vector<unsigned char>::iterator it = b256.begin() + (size - length);
-    while (it != b256.end() && *it == 0)
-      it++;
-    // Copy result into output vector.
-    vch.reserve(zeroes + (b256.end() - it));
-    vch.assign(zeroes, 0x00);
-    while (it != b256.end())
-      vch.push_back(*(it++));
-    return true;
+    return Base58::decode(psz, end - psz, vch);
   }
 
   static std::string EncodeBase58(const unsigned char *pbegin,
                                   const unsigned char *pend) {
-    // Skip & count leading zeroes.
-    int zeroes = 0;
-    int length = 0;
-    while (pbegin != pend && *pbegin == 0) {
-      pbegin++;
-      zeroes++;
-    }
-    // Allocate enough space in big-endian base58 representation.
-    int size =
-        (pend - pbegin) * 138 / 100 + 1; // log(256) / log(58), rounded up.
-    std::vector<unsigned char> b58(size);
-    // Process the bytes.
-    while (pbegin != pend) {
-      int carry = *pbegin;
-      int i = 0;
-      // Apply "b58 = b58 * 256 + ch".
-      for (std::vector<unsigned char>::reverse_iterator it = b58.rbegin();
-           (carry != 0 || i < length) && (it != b58.rend()); it++, i++) {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
-      }
-
-      assert(carry == 0);
-      length = i;
-      pbegin++;
-    }
-    // Skip leading zeroes in base58 result.
-    std::vector<unsigned char>::iterator it = b58.begin() + (size - length);
-    while (it != b58.end() && *it == 0)
-      it++;
-    // Translate the result into a string.
-    std::string str;
-    str.reserve(zeroes + (b58.end() - it));
-    str.assign(zeroes, '1');
-    while (it != b58.end())
-      str += pszBase58[*(it++)];
-    return str;
+    return Base58::encode(pbegin, pend - pbegin);
   }
 
   static std::string EncodeBase58(const std::vector<unsigned char> &vch) {
@@ -293,74 +150,60 @@ public:
   }
 
   // if with_new_line == true: NO_WRAP mode
-  // else NO_PADDING
-  static std::string base64Encode(std::string data, bool with_new_line) {
-    if (data.length() == 0) {
+  // else NO_PADDING, which encodes a trailing '\n' along with the data
+  static std::string base64Encode(const unsigned char *data, size_t len,
+                                  bool with_new_line) {
+    if (len == 0) {
       return "";
     }
-    BIO *b64 = BIO_new(BIO_f_base64());
-
-    if (!with_new_line) {
-      data.append("\n");
-      BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    }
-
-    BIO *mem = BIO_new(BIO_s_mem());
-    b64 = BIO_push(b64, mem);
-
-    BIO_write(b64, data.c_str(), data.length());
-    BIO_flush(b64);
-
-    BUF_MEM *pBuf = nullptr;
-    BIO_get_mem_ptr(mem, &pBuf);
-    std::string ret(pBuf->data);
-    free(pBuf);
-
-    BIO_set_close(b64, BIO_NOCLOSE);
-    BIO_free_all(b64);
+    std::string ret(Base64::encodedSize(with_new_line ? len : len + 1), '\0');
     if (with_new_line) {
-      return ret.substr(0, ret.length() - 1);
+      Base64::encode(data, len, &ret[0]);
+      return ret;
     }
+    size_t head = len / 3 * 3;
+    Base64::encode(data, head, &ret[0]);
+    unsigned char tail[3];
+    memcpy(tail, data + head, len - head);
+    tail[len - head] = '\n';
+    Base64::encode(tail, len - head + 1, &ret[head / 3 * 4]);
     return ret;
   }
 
+  static std::string base64Encode(const std::string &data,
+                                  bool with_new_line) {
+    return base64Encode((const unsigned char *)data.data(), data.size(),
+                        with_new_line);
+  }
+
   static std::string base64Encode(const std::vector<unsigned char> &data,
                                   bool with_new_line) {
-    std::string str_data(data.begin(), data.end());
-    return base64Encode(str_data, with_new_line);
+    return base64Encode(data.data(), data.size(), with_new_line);
   }
 
-  static std::string base64Decode(std::string data, bool with_new_line) {
-    size_t length = data.length();
-    if (length == 0) {
-      return "";
+  static std::vector<unsigned char>
+  base64DecodeBytes(const std::string &data, bool with_new_line) {
+    std::vector<unsigned char> ret;
+    if (data.empty()) {
+      return ret;
     }
-
-    BIO *b64 = BIO_new(BIO_f_base64());
-    if (!with_new_line) {
-      BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    } else {
-      data.append("\n");
+    ret.resize(Base64::decodedMaxSize(data.size()));
+    size_t len = 0;
+    if (!Base64::decode(data.data(), data.size(), ret.data(), len)) {
+      throw std::runtime_error("base64Decode error");
     }
-
-    BIO *mem = nullptr;
-    mem = BIO_new_mem_buf(const_cast<char *>(data.c_str()), -1);
-    mem = BIO_push(b64, mem);
-
-    char *buffer = (char *)malloc(length);
-    memset(buffer, 0, length);
-    BIO_read(mem, buffer, length);
-    if (!with_new_line) {
-      std::string ret(buffer, buffer + strlen(buffer) - 1);
-      free(buffer);
-      BIO_free_all(mem);
-      return ret;
-    } else {
-      std::string ret(buffer, buffer + strlen(buffer));
-      free(buffer);
-      BIO_free_all(mem);
-      return ret;
+    // NO_PADDING data ends with the '\n' base64Encode added
+    if (!with_new_line && len > 0) {
+      len--;
     }
+    ret.resize(len);
+    return ret;
+  }
+
+  static std::string base64Decode(const std::string &data,
+                                  bool with_new_line) {
+    std::vector<unsigned char> bytes = base64DecodeBytes(data, with_new_line);
+    return std::string(bytes.begin(), bytes.end());
   }
 
   static std::string base64Decode(const std::vector<unsigned char> &data,
@@ -0,0 +1,220 @@
+#ifndef HEX_H
+#define HEX_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Hex codec used by Helper. The vector width is picked at compile time:
+// AVX2 with -mavx2, SSE2 on any x86-64 build, plain table lookups elsewhere.
+// Encoding is always lowercase, decoding accepts both cases.
+class Hex {
+private:
+  static const char *digits() { return "0123456789abcdef"; }
+
+  // nibble value of a hex char, -1 for anything else
+  static int8_t nibble(unsigned char c) {
+    static const int8_t map[256] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    };
+    return map[c];
+  }
+
+  static void encodeScalar(const unsigned char *src, size_t len, char *dst) {
+    const char *hexmap = digits();
+    for (size_t i = 0; i < len; i++) {
+      dst[2 * i] = hexmap[src[i] >> 4];
+      dst[2 * i + 1] = hexmap[src[i] & 0x0F];
+    }
+  }
+
+  static bool decodeScalar(const char *src, size_t len, unsigned char *dst) {
+    for (size_t i = 0; i < len; i++) {
+      int8_t h = nibble((unsigned char)src[2 * i]);
+      int8_t l = nibble((unsigned char)src[2 * i + 1]);
+      if ((h | l) < 0) {
+        return false;
+      }
+      dst[i] = (unsigned char)((h << 4) | l);
+    }
+    return true;
+  }
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+  // nibbles (0..15 per byte) to ascii: '0' + n, plus 39 more for a..f
+  static __m128i nibblesToAscii(__m128i n) {
+    __m128i letter = _mm_cmpgt_epi8(n, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')),
+                        _mm_and_si128(letter, _mm_set1_epi8(39)));
+  }
+
+  // 16 input bytes -> 32 output chars
+  static void encode16(const unsigned char *src, char *dst) {
+    __m128i v = _mm_loadu_si128((const __m128i *)src);
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i hi = nibblesToAscii(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    __m128i lo = nibblesToAscii(_mm_and_si128(v, mask));
+    _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+
+  // ascii to nibbles, ok gets 0xFF for every valid hex char
+  static __m128i asciiToNibbles(__m128i c, __m128i &ok) {
+    __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i is_digit =
+        _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i alpha =
+        _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_alpha =
+        _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    ok = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+  }
+
+  // pairs of nibbles in each 16-bit lane -> one byte per lane
+  static __m128i joinNibbles(__m128i n) {
+    __m128i hi = _mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(hi, _mm_srli_epi16(n, 8));
+  }
+
+  // 32 input chars -> 16 output bytes
+  static bool decode16(const char *src, unsigned char *dst) {
+    __m128i ok0, ok1;
+    __m128i n0 = asciiToNibbles(_mm_loadu_si128((const __m128i *)src), ok0);
+    __m128i n1 =
+        asciiToNibbles(_mm_loadu_si128((const __m128i *)(src + 16)), ok1);
+    if (_mm_movemask_epi8(_mm_and_si128(ok0, ok1)) != 0xFFFF) {
+      return false;
+    }
+    _mm_storeu_si128((__m128i *)dst,
+                     _mm_packus_epi16(joinNibbles(n0), joinNibbles(n1)));
+    return true;
+  }
+#endif
+
+#if defined(__AVX2__)
+  static __m256i nibblesToAscii(__m256i n) {
+    __m256i letter = _mm256_cmpgt_epi8(n, _mm256_set1_epi8(9));
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')),
+                           _mm256_and_si256(letter, _mm256_set1_epi8(39)));
+  }
+
+  // 32 input bytes -> 64 output chars
+  static void encode32(const unsigned char *src, char *dst) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)src);
+    __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i hi =
+        nibblesToAscii(_mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+    __m256i lo = nibblesToAscii(_mm256_and_si256(v, mask));
+    // unpack works per 128-bit lane, put the halves back in order
+    __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst + 32),
+                        _mm256_permute2x128_si256(a, b, 0x31));
+  }
+
+  static __m256i asciiToNibbles(__m256i c, __m256i &ok) {
+    __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i is_digit =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i alpha = _mm256_sub_epi8(
+        _mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_alpha =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    ok = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_or_si256(
+        _mm256_and_si256(is_digit, digit),
+        _mm256_and_si256(is_alpha,
+                         _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+  }
+
+  static __m256i joinNibbles(__m256i n) {
+    __m256i hi =
+        _mm256_slli_epi16(_mm256_and_si256(n, _mm256_set1_epi16(0x00FF)), 4);
+    return _mm256_or_si256(hi, _mm256_srli_epi16(n, 8));
+  }
+
+  // 64 input chars -> 32 output bytes
+  static bool decode32(const char *src, unsigned char *dst) {
+    __m256i ok0, ok1;
+    __m256i n0 =
+        asciiToNibbles(_mm256_loadu_si256((const __m256i *)src), ok0);
+    __m256i n1 =
+        asciiToNibbles(_mm256_loadu_si256((const __m256i *)(src + 32)), ok1);
+    if (_mm256_movemask_epi8(_mm256_and_si256(ok0, ok1)) != -1) {
+      return false;
+    }
+    // pack works per 128-bit lane as well
+    __m256i packed = _mm256_packus_epi16(joinNibbles(n0), joinNibbles(n1));
+    _mm256_storeu_si256((__m256i *)dst,
+                        _mm256_permute4x64_epi64(packed, 0xD8));
+    return true;
+  }
+#endif
+
+public:
+  // writes 2 * len chars to dst, no terminator
+  static void encode(const unsigned char *src, size_t len, char *dst) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= len; i += 32) {
+      encode32(src + i, dst + 2 * i);
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= len; i += 16) {
+      encode16(src + i, dst + 2 * i);
+    }
+#endif
+    encodeScalar(src + i, len - i, dst + 2 * i);
+  }
+
+  // reads 2 * len chars from src into len bytes, false on a non-hex char
+  static bool decode(const char *src, size_t len, unsigned char *dst) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= len; i += 32) {
+      if (!decode32(src + 2 * i, dst + i)) {
+        return false;
+      }
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= len; i += 16) {
+      if (!decode16(src + 2 * i, dst + i)) {
+        return false;
+      }
+    }
+#endif
+    return decodeScalar(src + 2 * i, len - i, dst + i);
+  }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fixed set of worker threads draining one FIFO queue. submit() hands back
+// a future, exceptions thrown by a task are rethrown from future::get().
+class ThreadPool {
+private:
+  std::vector<std::thread> workers;
+  std::queue<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool stopping;
+
+  void run() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return stopping || !tasks.empty(); });
+        if (tasks.empty()) {
+          return;
+        }
+        task = std::move(tasks.front());
+        tasks.pop();
+      }
+      task();
+    }
+  }
+
+public:
+  // 0 picks one thread per hardware thread
+  explicit ThreadPool(size_t threads = 0) : stopping(false) {
+    if (threads == 0) {
+      threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+      threads = 1;
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      workers.emplace_back(&ThreadPool::run, this);
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // runs the tasks already queued, then joins
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i].join();
+    }
+  }
+
+  size_t size() const { return workers.size(); }
+
+  template <class F>
+  std::future<decltype(std::declval<F &>()())> submit(F f) {
+    typedef decltype(std::declval<F &>()()) R;
+    std::shared_ptr<std::packaged_task<R()>> task =
+        std::make_shared<std::packaged_task<R()>>(std::move(f));
+    std::future<R> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stopping) {
+        throw std::runtime_error("ThreadPool is stopping");
+      }
+      tasks.push([task]() { (*task)(); });
+    }
+    cond.notify_one();
+    return result;
+  }
+};
+
+#endif
@@ -64,8 +64,12 @@ public:
 
   std::vector<unsigned char> get_data_bytes() const { return data_bytes; }
 
+  const std::vector<unsigned char> &bytes() const { return data_bytes; }
+
   void serialize(BinaryWriter *writer) { writer->write(data_bytes); }
 
+  size_t serializedSize() { return data_bytes.size(); }
+
   void deserialize(BinaryReader *reader) { reader->read(data_bytes); }
 
   std::vector<unsigned char> toArray() { return data_bytes; }
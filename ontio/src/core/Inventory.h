@@ -5,39 +5,73 @@
     #error "use --std=c++11 option for compile."
 #endif
 
+#include <algorithm>
+
 #include "../crypto/Digest.h"
 #include "Signable.h"
 
 class Inventory : public Signable
 {
 private:
-  std::vector<unsigned char> _hash;
+  Digest::Hash256 _hash;
+  bool _hash_valid;
 
 protected:
-  Inventory() : Signable() {}
+  Inventory() : Signable(), _hash_valid(false) {}
 
 public:
-  std::vector<unsigned char> hash()
+  void invalidateHash() override
+  {
+    Signable::invalidateHash();
+    _hash_valid = false;
+  }
+
+  // the byte reversed dataHash(), shares its serialization with signing
+  const Digest::Hash256 &hashArray()
   {
-    if (_hash.empty())
+    if (!_hash_valid)
     {
-      std::vector<unsigned char> hash_data;
-      hash_data = getHashData();
-      _hash = Digest::hash256(hash_data);
+      _hash = dataHash();
       int n = 1;
       // little endian if true
       if (*(char *)&n == 1)
       {
-        std::vector<unsigned char> inver_hash;
-        size_t vec_sz = _hash.size();
-        for (int i = (int)vec_sz - 1; i > -1; i--)
-        {
-          inver_hash.push_back(_hash[i]);
-        }
-        _hash = inver_hash;
+        std::reverse(_hash.begin(), _hash.end());
       }
+      _hash_valid = true;
     }
     return _hash;
   }
+
+  // fills the hash cache of many items at once through
+  // Digest::hash256Batch, e.g. before reading txids out of a block
+  template <class T>
+  static void hashBatch(std::vector<T> &items)
+  {
+    std::vector<std::vector<unsigned char>> hash_data(items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+      hash_data[i] = items[i].getHashData();
+    }
+    std::vector<Digest::Hash256> hashes = Digest::hash256Batch(hash_data);
+    for (size_t i = 0; i < items.size(); i++)
+    {
+      Inventory &inventory = items[i];
+      inventory._hash = hashes[i];
+      int n = 1;
+      // little endian if true
+      if (*(char *)&n == 1)
+      {
+        std::reverse(inventory._hash.begin(), inventory._hash.end());
+      }
+      inventory._hash_valid = true;
+    }
+  }
+
+  std::vector<unsigned char> hash()
+  {
+    const Digest::Hash256 &hash_uc = hashArray();
+    return std::vector<unsigned char>(hash_uc.begin(), hash_uc.end());
+  }
 };
 #endif
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "../account/Account.h"
 #include "../common/Address.h"
 #include "../common/UIntBase.h"
+#include "../crypto/Digest.h"
 #include "../crypto/Signature.h"
 #include "../io/BinaryReader.h"
 #include "../io/BinaryWriter.h"
@@ -17,28 +18,93 @@
 
 class Signable : public Serializable
 {
+private:
+  // unsigned encoding and its digests, valid until invalidateHash()
+  std::vector<unsigned char> _hash_data;
+  Digest::Hash256 _data_hash;
+  Digest::Hash256 _sign_hash;
+  bool _hash_data_valid;
+
+  void updateHashData()
+  {
+    BinaryWriter writer(serializedUnsignedSize());
+    serializeUnsigned(&writer);
+    _hash_data = std::move(writer).take();
+    _data_hash = Digest::hash256(_hash_data.data(), _hash_data.size());
+    // hash256(sha256(data)) == sha256(hash256(data))
+    _sign_hash = Digest::sha256(_data_hash.data(), _data_hash.size());
+    _hash_data_valid = true;
+  }
+
 protected:
-  Signable() : Serializable() {}
+  Signable() : Serializable(), _hash_data_valid(false) {}
 
 public:
+  // must be called after any field serializeUnsigned() writes has changed,
+  // the Transaction setters do it themselves
+  virtual void invalidateHash()
+  {
+    _hash_data_valid = false;
+    _hash_data.clear();
+  }
+
+  // cached serializeUnsigned() output
+  const std::vector<unsigned char> &hashData()
+  {
+    if (!_hash_data_valid)
+    {
+      updateHashData();
+    }
+    return _hash_data;
+  }
+
+  // cached hash256 of hashData(), in digest byte order
+  const Digest::Hash256 &dataHash()
+  {
+    if (!_hash_data_valid)
+    {
+      updateHashData();
+    }
+    return _data_hash;
+  }
+
+  // cached digest every signer signs, hash256(sha256(hashData()))
+  const Digest::Hash256 &signHash()
+  {
+    if (!_hash_data_valid)
+    {
+      updateHashData();
+    }
+    return _sign_hash;
+  }
+
   virtual void deserializeUnsigned(BinaryReader *reader) = 0;
   virtual void serializeUnsigned(BinaryWriter *writer) = 0;
+  // exact number of bytes serializeUnsigned() writes
+  virtual size_t serializedUnsignedSize() = 0;
 
   std::vector<unsigned char> getHashData()
   {
-    BinaryWriter writer;
+    BinaryWriter writer(serializedUnsignedSize());
+    serializeUnsigned(&writer);
+    return std::move(writer).take();
+  }
+
+  // serializes into a caller-owned writer, e.g. one per thread, and returns a
+  // view of its buffer that stays valid until the writer is used again
+  const std::vector<unsigned char> &getHashData(BinaryWriter &writer)
+  {
+    writer.reset();
+    writer.reserve(serializedUnsignedSize());
     serializeUnsigned(&writer);
-    std::vector<unsigned char> bytes;
-    bytes = writer.toByteArray();
-    return bytes;
+    return writer.bytes();
   }
 
   std::vector<unsigned char> sign(Account account, SignatureScheme scheme,
                                   CurveName curve)
   {
-    std::vector<unsigned char> hash_data;
-    hash_data = Digest::hash256(Digest::sha256(getHashData()));
-    return account.generateSignature(hash_data);
+    const Digest::Hash256 &sign_hash = signHash();
+    return account.generateSignature(sign_hash.data(), sign_hash.size());
   }
 
   std::string sign_str(Account account, SignatureScheme scheme,
@@ -22,7 +22,7 @@ private:
   std::vector<std::string> sigData;
 
 public:
-  Sig() {}
+  Sig() : M(0) {}
   Sig(const std::vector<std::string> &_pubKeys, int _M,
       const std::vector<std::string> &_sigData)
       : M(_M)
@@ -38,6 +38,12 @@ public:
 
   int sigData_length() { return (int)sigData.size(); }
 
+  const std::vector<std::string> &getPubKeys() const { return pubKeys; }
+
+  const std::vector<std::string> &getSigData() const { return sigData; }
+
+  int getM() const { return M; }
+
   void add_sigData(std::vector<unsigned char> &_sig_data)
   {
     std::string str(_sig_data.begin(), _sig_data.end());
@@ -68,6 +74,26 @@ public:
     }
   }
 
+  size_t serializedSize()
+  {
+    size_t key_sz = pubKeys.size();
+    size_t program_sz;
+    if (key_sz == 1)
+    {
+      program_sz = Program::ProgramFromPubKeySize(pubKeys[0]);
+    }
+    else if (key_sz > 1)
+    {
+      program_sz = Program::ProgramFromMultiPubKeySize(pubKeys);
+    }
+    else
+    {
+      throw std::runtime_error("Sig serialize error.");
+    }
+    return BinaryWriter::varBytesSize(Program::ProgramFromParamsSize(sigData)) +
+           BinaryWriter::varBytesSize(program_sz);
+  }
+
   void deserialize(BinaryReader *reader)
   {
     long long pub_key_len = reader->readVarInt();
@@ -30,6 +30,11 @@ public:
     writer->writeVarInt(value);
   }
 
+  size_t serializedSize() {
+    return from.serializedSize() + to.serializedSize() +
+           BinaryWriter::varIntSize(value);
+  }
+
   void deserialize(BinaryReader *reader) {
     try {
       reader->readSerializable(from);
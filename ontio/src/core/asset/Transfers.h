@@ -34,6 +34,10 @@ public:
   void serialize(BinaryWriter *writer) {
     writer->writeSerializableArray(states);
   }
+
+  size_t serializedSize() {
+    return BinaryWriter::serializableArraySize(states);
+  }
 };
 
 #endif
\ No newline at end of file
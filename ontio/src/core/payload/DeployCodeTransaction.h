@@ -32,7 +32,7 @@ class DeployCodeTransaction : public Transaction
     {
         try
         {
-            code = reader->readVarBytes();
+            code = reader->readVarBytes_vec();
             needStorage = reader->readBool();
             name = reader->readVarString();
             version = reader->readVarString();
@@ -51,7 +51,7 @@ class DeployCodeTransaction : public Transaction
         try
         {
             writer->writeVarBytes(code);
-            writer->writeBoolean(needStorage);
+            writer->writeBool(needStorage);
             writer->writeVarString(name);
             writer->writeVarString(version);
             writer->writeVarString(author);
@@ -62,6 +62,16 @@ class DeployCodeTransaction : public Transaction
             std::cerr << e.what() << std::endl;
         }
     }
+
+    size_t serializedExclusiveDataSize() override
+    {
+        return BinaryWriter::varBytesSize(code.size()) + 1 +
+               BinaryWriter::varBytesSize(name.size()) +
+               BinaryWriter::varBytesSize(version.size()) +
+               BinaryWriter::varBytesSize(author.size()) +
+               BinaryWriter::varBytesSize(email.size()) +
+               BinaryWriter::varBytesSize(description.size());
+    }
 };
 
 #endif
\ No newline at end of file
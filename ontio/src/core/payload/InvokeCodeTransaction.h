@@ -50,6 +50,10 @@ public:
   {
     writer->writeVarBytes(code);
   }
+  size_t serializedExclusiveDataSize()
+  {
+    return BinaryWriter::varBytesSize(code.size());
+  }
   void deserializeExclusiveData(BinaryReader *reader)
   {
     try
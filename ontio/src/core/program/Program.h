@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <openssl/ec.h>
@@ -16,9 +17,7 @@
 #include "../../common/Helper.h"
 #include "../../core/scripts/ScriptBuilder.h"
 #include "../../crypto/Curve.h"
-#include "../../crypto/ECC.h"
-#include "../../crypto/ECDomainParameters.h"
-#include "../../crypto/KeyType.hpp"
+#include "../../crypto/PublicKeyCache.h"
 #include "../../sdk/exception/SDKException.h"
 
 class Program
@@ -50,39 +49,61 @@ public:
     return builder.toArray();
   }
 
-  static void sortPublicKeys(std::vector<std::string> &publicKeys)
+  static size_t ProgramFromParamsSize(const std::vector<std::string> &sigData)
   {
-    std::sort(publicKeys.begin(), publicKeys.end(), [](std::string &o1, std::string &o2) -> int {
-      int o1_label = KeyTypeMethod::getLabel(KeyTypeMethod::fromPubkey(o1));
-      int o2_label = KeyTypeMethod::getLabel(KeyTypeMethod::fromPubkey(o2));
-      if (o1_label != o2_label)
-      {
-        return (o1_label > o2_label ? 1 : -1);
-      }
-      ECC ecc;
-      int result;
-      switch (KeyTypeMethod::fromPubkey(o1))
+    size_t sz = 0;
+    for (size_t i = 0; i < sigData.size(); i++)
+    {
+      sz += ScriptBuilder::pushSize(sigData[i].size());
+    }
+    return sz;
+  }
+
+  static size_t ProgramFromPubKeySize(const std::string &publicKey)
+  {
+    // push(publicKey), OP_CHECKSIG
+    return ScriptBuilder::pushSize(publicKey.size()) + 1;
+  }
+
+  static size_t
+  ProgramFromMultiPubKeySize(const std::vector<std::string> &publicKeys)
+  {
+    // push(m), n hex public keys, push(n), OP_CHECKMULTISIG
+    size_t sz = 1;
+    for (size_t i = 0; i < publicKeys.size(); i++)
+    {
+      size_t hex_len = publicKeys[i].size();
+      if (hex_len >= 2 && publicKeys[i][0] == '0' &&
+          (publicKeys[i][1] == 'x' || publicKeys[i][1] == 'X'))
       {
-      case KeyType::SM2:
-        // TODO
-        result = o1.compare(o2);
-        break;
-      case KeyType::ECDSA:
-        EC_POINT *o1_ec_point;
-        o1_ec_point = ecc.secp256r1->convert_EC_Point(o1);
-        EC_POINT *o2_ec_point;
-        o2_ec_point = ecc.secp256r1->convert_EC_Point(o2);
-        result = ecc.secp256r1->compare(o1_ec_point, o2_ec_point);
-        break;
-      case KeyType::EDDSA:
-        // TODO
-        break;
-      default:
-        result = o1.compare(o2);
-        break;
+        hex_len -= 2;
       }
-      return result;
-    });
+      sz += ScriptBuilder::pushSize(hex_len / 2);
+    }
+    return sz + 1 + 1;
+  }
+
+  // orders keys by type label, then by the x and y of their points. Each
+  // key is decoded once, through the shared PublicKeyCache.
+  static void sortPublicKeys(std::vector<std::string> &publicKeys)
+  {
+    PublicKeyCache &cache = PublicKeyCache::shared();
+    std::vector<std::pair<DecodedPublicKey, std::string>> keys;
+    keys.reserve(publicKeys.size());
+    for (size_t i = 0; i < publicKeys.size(); i++)
+    {
+      keys.push_back(std::make_pair(cache.get(publicKeys[i]), publicKeys[i]));
+    }
+    std::sort(keys.begin(), keys.end(),
+              [](const std::pair<DecodedPublicKey, std::string> &o1,
+                 const std::pair<DecodedPublicKey, std::string> &o2) {
+                int result = o1.first.compare(o2.first);
+                return result != 0 ? result < 0 : o1.second < o2.second;
+              });
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+      publicKeys[i].swap(keys[i].second);
+    }
   }
 
   static std::vector<unsigned char>
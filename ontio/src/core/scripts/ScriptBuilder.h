@@ -134,6 +134,18 @@ public:
     return *this;
   }
 
+  // bytes push(data) appends for data of the given length
+  static size_t pushSize(size_t data_len) {
+    if (data_len <= (size_t)ScriptOpMethod::getByte(ScriptOp::OP_PUSHBYTES75)) {
+      return 1 + data_len;
+    } else if (data_len < 0x100) {
+      return 2 + data_len;
+    } else if (data_len < 0x10000) {
+      return 3 + data_len;
+    }
+    return 5 + data_len;
+  }
+
   ScriptBuilder pushHexStr(const std::string &str) {
     std::vector<unsigned char> byte_uc;
     byte_uc = Helper::hexStringToByte(str);
@@ -154,7 +166,7 @@ public:
     if (BN_is_zero(bn)) {
       return add(ScriptOpMethod::getByte(ScriptOp::OP_0));
     }
-    if (BN_get_word(bn) > 0 && BN_get_word(bn) < 16) {
+    if (BN_get_word(bn) > 0 && BN_get_word(bn) <= 16) {
       return add(((unsigned long)ScriptOpMethod::getByte(ScriptOp::OP_1) - 1 +
                   BN_get_word(bn)));
     }
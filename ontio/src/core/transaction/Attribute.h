@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include <boost/multiprecision/cpp_int.hpp>
 #include <nlohmann/json.hpp>
 
 #include "../../io/BinaryReader.h"
@@ -60,6 +61,18 @@ public:
     }
   }
 
+  size_t serializedSize()
+  {
+    if (usage == AttributeUsage::Script ||
+        usage == AttributeUsage::DescriptionUrl ||
+        usage == AttributeUsage::Description ||
+        usage == AttributeUsage::Nonce)
+    {
+      return 1 + BinaryWriter::varBytesSize(data.size());
+    }
+    return 1;
+  }
+
   void deserialize(BinaryReader *reader)
   {
     try
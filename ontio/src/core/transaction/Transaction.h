@@ -82,17 +82,19 @@ public:
     this->attributes = tx.attributes;
     this->sigs = tx.sigs;
     this->nonce = tx.nonce;
+    invalidateHash();
     return *this;
   }
 
   std::vector<unsigned char> getHashData()
   {
-    BinaryWriter writer;
-    BinaryWriter *p_writer = &writer;
-    serializeUnsigned(p_writer);
-    return writer.toByteArray();
+    BinaryWriter writer(serializedUnsignedSize());
+    serializeUnsigned(&writer);
+    return std::move(writer).take();
   }
 
+  using Signable::getHashData;
+
   void add_sig(const Sig &sig) { sigs.push_back(sig); }
 
   void add_sigs(const std::vector<Sig> &_sigs)
@@ -118,7 +120,41 @@ public:
 
   bool sigs_empty() { return sigs.empty(); }
 
-  void set_payer(Address _payer) { payer = _payer; }
+  void set_payer(Address _payer)
+  {
+    payer = _payer;
+    invalidateHash();
+  }
+
+  void set_gasPrice(long long _gasPrice)
+  {
+    gasPrice = _gasPrice;
+    invalidateHash();
+  }
+
+  void set_gasLimit(long long _gasLimit)
+  {
+    gasLimit = _gasLimit;
+    invalidateHash();
+  }
+
+  void set_nonce(int _nonce)
+  {
+    nonce = _nonce;
+    invalidateHash();
+  }
+
+  void set_attributes(const std::vector<Attribute> &_attributes)
+  {
+    attributes = _attributes;
+    invalidateHash();
+  }
+
+  void add_attribute(const Attribute &attribute)
+  {
+    attributes.push_back(attribute);
+    invalidateHash();
+  }
 
   nlohmann::json json()
   {
@@ -153,6 +189,20 @@ public:
   }
 
   virtual void serializeExclusiveData(BinaryWriter *writer) = 0;
+  virtual size_t serializedExclusiveDataSize() = 0;
+
+  size_t serializedUnsignedSize() override
+  {
+    // version, type, nonce, gasPrice, gasLimit
+    return 1 + 1 + 4 + 8 + 8 + payer.serializedSize() +
+           serializedExclusiveDataSize() +
+           BinaryWriter::serializableArraySize(attributes);
+  }
+
+  size_t serializedSize() override
+  {
+    return serializedUnsignedSize() + BinaryWriter::serializableArraySize(sigs);
+  }
 
   void serialize(BinaryWriter *writer)
   {
@@ -192,12 +242,12 @@ public:
     {
       throw "IOException";
     }
+    nonce = (int)reader->readInt();
     gasPrice = reader->readLong();
     gasLimit = reader->readLong();
-    // try{
-
-    // }
+    reader->readSerializable(payer);
     deserializeUnsignedWithoutType(reader);
+    invalidateHash();
   }
 
   void deserializeUnsignedWithoutType(BinaryReader *reader)
@@ -10,42 +10,184 @@
 /* 16 byte block size (128 bits) */
 #define AES_BLOCK_SIZE 16
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 
 #include "../common/Helper.h"
 #include "Digest.h"
 
-class AES
+// AES-256-GCM with one EVP_CIPHER_CTX for the lifetime of the object.
+// The cipher is looked up and the context allocated once; setKey() only
+// expands a new key schedule and each message only installs its IV, so
+// encrypting a wallet's worth of private keys costs one context, not one
+// per key. Output is ciphertext || 16 byte tag, the layout Java's
+// AES/GCM/NoPadding produces. Not safe to share between threads.
+class AesGcm
 {
   private:
-    static inline void setPadding(EVP_CIPHER_CTX *ctx, bool padding)
+    std::unique_ptr<EVP_CIPHER_CTX, void (*)(EVP_CIPHER_CTX *)> enc;
+    std::unique_ptr<EVP_CIPHER_CTX, void (*)(EVP_CIPHER_CTX *)> dec;
+
+    static void check(int ok, const char *what)
+    {
+        if (ok != 1)
+        {
+            throw std::runtime_error(what);
+        }
+    }
+
+    static void setIv(EVP_CIPHER_CTX *ctx, const unsigned char *iv,
+                      size_t iv_len, bool encrypt)
     {
-        if (padding)
+        if (iv_len == 0)
         {
-            EVP_CIPHER_CTX_set_padding(ctx, 1);
+            throw std::runtime_error("AES-GCM needs an IV");
         }
-        else
+        check(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, (int)iv_len,
+                                  nullptr),
+              "EVP_CIPHER_CTX_ctrl() fail.");
+        check(EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv,
+                                encrypt ? 1 : 0),
+              "EVP_CipherInit_ex() fail.");
+    }
+
+  public:
+    static const size_t TAG_SIZE = 16;
+
+    AesGcm()
+        : enc(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free),
+          dec(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free)
+    {
+        if (!enc || !dec)
         {
-            EVP_CIPHER_CTX_set_padding(ctx, 0);
+            throw std::runtime_error("EVP_CIPHER_CTX_new() failed.");
         }
+        check(EVP_EncryptInit_ex(enc.get(), EVP_aes_256_gcm(), nullptr,
+                                 nullptr, nullptr),
+              "EVP_EncryptInit_ex() fail.");
+        check(EVP_DecryptInit_ex(dec.get(), EVP_aes_256_gcm(), nullptr,
+                                 nullptr, nullptr),
+              "EVP_DecryptInit_ex() fail.");
+    }
+
+    explicit AesGcm(const std::vector<unsigned char> &key) : AesGcm()
+    {
+        setKey(key);
     }
 
-    static inline void checkArgument(const std::vector<unsigned char> &key,
-                                     const std::vector<unsigned char> &iv,
-                                     const EVP_CIPHER *cipher)
+    // key must be 32 bytes
+    void setKey(const std::vector<unsigned char> &key)
     {
-        if ((int)key.size() != EVP_CIPHER_key_length(cipher) ||
-            (int)iv.size() != EVP_CIPHER_iv_length(cipher))
+        if (key.size() != AES_256_KEY_SIZE)
         {
             throw std::runtime_error("IllegalArgumentException");
         }
+        check(EVP_EncryptInit_ex(enc.get(), nullptr, nullptr, key.data(),
+                                 nullptr),
+              "EVP_EncryptInit_ex() fail.");
+        check(EVP_DecryptInit_ex(dec.get(), nullptr, nullptr, key.data(),
+                                 nullptr),
+              "EVP_DecryptInit_ex() fail.");
+    }
+
+    // writes len bytes of ciphertext to out and the tag to tag
+    void encrypt(const unsigned char *plaintext, size_t len,
+                 const unsigned char *iv, size_t iv_len,
+                 const unsigned char *aad, size_t aad_len, unsigned char *out,
+                 unsigned char *tag)
+    {
+        EVP_CIPHER_CTX *ctx = enc.get();
+        setIv(ctx, iv, iv_len, true);
+        int out_len = 0;
+        if (aad_len > 0)
+        {
+            check(EVP_EncryptUpdate(ctx, nullptr, &out_len, aad, (int)aad_len),
+                  "EVP_EncryptUpdate() fail.");
+        }
+        if (len > 0)
+        {
+            check(EVP_EncryptUpdate(ctx, out, &out_len, plaintext, (int)len),
+                  "EVP_EncryptUpdate() fail.");
+        }
+        // GCM writes nothing on final
+        check(EVP_EncryptFinal_ex(ctx, out + len, &out_len),
+              "EVP_EncryptFinal_ex() fail");
+        check(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, (int)TAG_SIZE,
+                                  tag),
+              "EVP_CIPHER_CTX_ctrl() fail.");
+    }
+
+    // false, with out wiped, when the tag does not authenticate
+    bool decrypt(const unsigned char *ciphertext, size_t len,
+                 const unsigned char *tag, const unsigned char *iv,
+                 size_t iv_len, const unsigned char *aad, size_t aad_len,
+                 unsigned char *out)
+    {
+        EVP_CIPHER_CTX *ctx = dec.get();
+        setIv(ctx, iv, iv_len, false);
+        int out_len = 0;
+        if (aad_len > 0)
+        {
+            check(EVP_DecryptUpdate(ctx, nullptr, &out_len, aad, (int)aad_len),
+                  "EVP_DecryptUpdate() fail.");
+        }
+        if (len > 0)
+        {
+            check(EVP_DecryptUpdate(ctx, out, &out_len, ciphertext, (int)len),
+                  "EVP_DecryptUpdate() fail.");
+        }
+        check(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, (int)TAG_SIZE,
+                                  (void *)tag),
+              "EVP_CIPHER_CTX_ctrl() fail.");
+        if (EVP_DecryptFinal_ex(ctx, out + len, &out_len) != 1)
+        {
+            OPENSSL_cleanse(out, len);
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<unsigned char>
+    encrypt(const std::vector<unsigned char> &plaintext,
+            const std::vector<unsigned char> &iv,
+            const std::vector<unsigned char> &aad = std::vector<unsigned char>())
+    {
+        std::vector<unsigned char> sealed(plaintext.size() + TAG_SIZE);
+        encrypt(plaintext.data(), plaintext.size(), iv.data(), iv.size(),
+                aad.data(), aad.size(), sealed.data(),
+                sealed.data() + plaintext.size());
+        return sealed;
+    }
+
+    // sealed is ciphertext || tag; throws when it does not authenticate
+    std::vector<unsigned char>
+    decrypt(const std::vector<unsigned char> &sealed,
+            const std::vector<unsigned char> &iv,
+            const std::vector<unsigned char> &aad = std::vector<unsigned char>())
+    {
+        if (sealed.size() < TAG_SIZE)
+        {
+            throw std::runtime_error("AES-GCM ciphertext shorter than its tag");
+        }
+        size_t len = sealed.size() - TAG_SIZE;
+        std::vector<unsigned char> plaintext(len);
+        if (!decrypt(sealed.data(), len, sealed.data() + len, iv.data(),
+                     iv.size(), aad.data(), aad.size(), plaintext.data()))
+        {
+            throw std::runtime_error("AES-GCM tag mismatch");
+        }
+        return plaintext;
     }
+};
 
+class AES
+{
   public:
     static std::vector<unsigned char> generateKey(const std::string &password)
     {
@@ -74,6 +216,7 @@ class AES
         return std::vector<unsigned char>(iv, iv + AES_BLOCK_SIZE);
     }
 
+    // ciphertext and tag are resized to fit, returns the ciphertext length
     static int encrypt(const std::vector<unsigned char> &plaintext,
                        const std::vector<unsigned char> &aad,
                        const std::vector<unsigned char> &key,
@@ -81,190 +224,106 @@ class AES
                        std::vector<unsigned char> &ciphertext,
                        std::vector<unsigned char> &tag)
     {
-
-        EVP_CIPHER_CTX *ctx;
-
-        int len;
-
-        int ciphertext_len;
-
-        /* Create and initialise the context */
-        if (!(ctx = EVP_CIPHER_CTX_new()))
-        {
-            throw std::runtime_error("Error");
-        }
-
-        /* Initialise the encryption operation. */
-        if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL))
-        {
-            throw std::runtime_error("Error");
-        }
-
-        /* Set IV length if default 12 bytes (96 bits) is not appropriate */
-        if (1 !=
-            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 16, NULL))
-        {
-            throw std::runtime_error("Error");
-        }
-        std::cout << EVP_CIPHER_CTX_iv_length(ctx) << std::endl;
-
-        /* Initialise key and IV */
-        if (1 != EVP_EncryptInit_ex(ctx, NULL, NULL, key.data(), iv.data()))
-        {
-            throw std::runtime_error("Error");
-        }
-
-        /* Provide any AAD data. This can be called zero or more times as
-     * required
-     */
-        if (1 != EVP_EncryptUpdate(ctx, NULL, &len, aad.data(), aad.size()))
-        {
-            throw std::runtime_error("Error");
-        }
-
-        /* Provide the message to be encrypted, and obtain the encrypted output.
-     * EVP_EncryptUpdate can be called multiple times if necessary
-     */
-        if (1 != EVP_EncryptUpdate(ctx, ciphertext.data(), &len, plaintext.data(),
-                                   plaintext.size()))
-        {
-            throw std::runtime_error("Error");
-        }
-        ciphertext_len = len;
-
-        /* Finalise the encryption. Normally ciphertext bytes may be written at
-     * this stage, but this does not occur in GCM mode
-     */
-        if (1 != EVP_EncryptFinal_ex(ctx, ciphertext.data() + len, &len))
-        {
-            throw std::runtime_error("Error");
-        }
-        ciphertext_len += len;
-
-        /* Get the tag */
-        if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, tag.data()))
-        {
-            throw std::runtime_error("Error");
-        }
-
-        /* Clean up */
-        EVP_CIPHER_CTX_free(ctx);
-
-        return ciphertext_len;
+        AesGcm &gcm = threadCipher();
+        gcm.setKey(key);
+        ciphertext.resize(plaintext.size());
+        tag.resize(AesGcm::TAG_SIZE);
+        gcm.encrypt(plaintext.data(), plaintext.size(), iv.data(), iv.size(),
+                    aad.data(), aad.size(), ciphertext.data(), tag.data());
+        return (int)ciphertext.size();
     }
 
+    // ciphertext || tag. GCM is a stream mode, padding is ignored.
     static std::vector<unsigned char>
     gcmEncrypt(const std::vector<unsigned char> &plaintext,
                const std::vector<unsigned char> &key,
-               const std::vector<unsigned char> &iv, bool padding)
+               const std::vector<unsigned char> &iv, bool padding,
+               const std::vector<unsigned char> &aad =
+                   std::vector<unsigned char>())
     {
-        // checkArgument(key, iv, EVP_aes_256_gcm());
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-        EVP_CIPHER_CTX_init(ctx);
-        if (ctx == nullptr)
-        {
-            throw std::runtime_error("EVP_CIPHER_CTX_new() failed.");
-        }
-
-        /* Initialise the encryption operation. */
-        if (1 !=
-            EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr))
-        {
-            throw std::runtime_error("EVP_EncryptInit_ex() fail.");
-        }
-        /* Set IV length if default 12 bytes (96 bits) is not appropriate */
-        if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 16, nullptr))
-        {
-            throw std::runtime_error("EVP_CIPHER_CTX_ctrl() fail.");
-        }
-        std::cout << EVP_CIPHER_CTX_iv_length(ctx) << std::endl;
-
-        setPadding(ctx, padding);
-        /* set key and IV */
-        if (1 != EVP_EncryptInit_ex(ctx, nullptr, nullptr, key.data(), iv.data()))
-        {
-            throw std::runtime_error("EVP_EncryptInit_ex() fail.");
-        }
-        /* check lengths */
-        if (EVP_CIPHER_CTX_key_length(ctx) !=
-            EVP_CIPHER_key_length(EVP_aes_256_gcm()))
-        {
-            throw std::runtime_error(
-                "EVP_CIPHER_CTX_key_length(ctx) != AES_256_KEY_SIZE");
-        }
-        if (EVP_CIPHER_CTX_iv_length(ctx) !=
-            EVP_CIPHER_iv_length(EVP_aes_256_gcm()))
-        {
-            throw std::runtime_error(
-                "EVP_CIPHER_CTX_iv_length(ctx) != AES_BLOCK_SIZE");
-        }
-        /* Allow enough space in output buffer for additional block */
-        int cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
-        unsigned char out_buf[(int)plaintext.size() + cipher_block_size];
-
-        int out_len;
-        if (EVP_EncryptUpdate(ctx, out_buf, &out_len, plaintext.data(),
-                              plaintext.size()) != 1)
-        {
-            EVP_CIPHER_CTX_cleanup(ctx);
-            throw std::runtime_error("EVP_EncryptUpdate() fail.");
-        }
-
-        if (1 != EVP_EncryptFinal_ex(ctx, out_buf, &out_len))
-        {
-            EVP_CIPHER_CTX_cleanup(ctx);
-            throw std::runtime_error("EVP_EncryptFinal_ex() fail");
-        }
-        std::cout << out_buf << std::endl;
-        std::vector<unsigned char> vec(out_buf, out_buf + (int)plaintext.size() +
-                                                    cipher_block_size);
-        return vec;
+        (void)padding;
+        AesGcm &gcm = threadCipher();
+        gcm.setKey(key);
+        return gcm.encrypt(plaintext, iv, aad);
     }
 
+    // takes ciphertext || tag, throws when the tag does not authenticate
     static std::vector<unsigned char>
     gcmDecrypt(const std::vector<unsigned char> &ciphertext,
                const std::vector<unsigned char> &key,
-               const std::vector<unsigned char> &iv, bool padding)
+               const std::vector<unsigned char> &iv, bool padding,
+               const std::vector<unsigned char> &aad =
+                   std::vector<unsigned char>())
     {
-        checkArgument(key, iv, EVP_aes_256_gcm());
+        (void)padding;
+        AesGcm &gcm = threadCipher();
+        gcm.setKey(key);
+        return gcm.decrypt(ciphertext, iv, aad);
+    }
 
-        EVP_CIPHER_CTX *ctx;
-        ctx = EVP_CIPHER_CTX_new();
-        EVP_CIPHER_CTX_init(ctx);
-        if (ctx == nullptr)
-        {
-            throw std::runtime_error("EVP_CIPHER_CTX_init() failed.");
-        }
-        setPadding(ctx, padding);
+    // result[i] = gcmEncrypt(plaintexts[i], keys[i], ivs[i]) with the aad
+    // of aads[i] when aads is not empty. One cipher context serves the
+    // whole batch and a key is only expanded when it differs from the
+    // previous item's.
+    static std::vector<std::vector<unsigned char>>
+    gcmEncryptBatch(const std::vector<std::vector<unsigned char>> &plaintexts,
+                    const std::vector<std::vector<unsigned char>> &keys,
+                    const std::vector<std::vector<unsigned char>> &ivs,
+                    const std::vector<std::vector<unsigned char>> &aads =
+                        std::vector<std::vector<unsigned char>>())
+    {
+        return gcmBatch(true, plaintexts, keys, ivs, aads);
+    }
 
-        /* set key and IV */
-        if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key.data(),
-                               iv.data()) != 1)
-        {
-            throw std::runtime_error("EVP_DecryptInit_ex()");
-        }
+    // the inverse of gcmEncryptBatch, throws if any item fails to
+    // authenticate
+    static std::vector<std::vector<unsigned char>>
+    gcmDecryptBatch(const std::vector<std::vector<unsigned char>> &ciphertexts,
+                    const std::vector<std::vector<unsigned char>> &keys,
+                    const std::vector<std::vector<unsigned char>> &ivs,
+                    const std::vector<std::vector<unsigned char>> &aads =
+                        std::vector<std::vector<unsigned char>>())
+    {
+        return gcmBatch(false, ciphertexts, keys, ivs, aads);
+    }
 
-        /* Allow enough space in output buffer for additional block */
-        int buf_size = (int)ciphertext.size();
-        int cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
-        unsigned char out_buf[buf_size + cipher_block_size];
+  private:
+    // one context per thread behind the single message calls, so they
+    // only pay for the key schedule. The last key's schedule stays in it
+    // until the next call or thread exit, when OpenSSL wipes it.
+    static AesGcm &threadCipher()
+    {
+        static thread_local AesGcm gcm;
+        return gcm;
+    }
 
-        int out_len;
-        if (EVP_DecryptUpdate(ctx, out_buf, &out_len,
-                              (const unsigned char *)ciphertext.data(),
-                              ciphertext.size()) != 1)
+    static std::vector<std::vector<unsigned char>>
+    gcmBatch(bool encrypt, const std::vector<std::vector<unsigned char>> &in,
+             const std::vector<std::vector<unsigned char>> &keys,
+             const std::vector<std::vector<unsigned char>> &ivs,
+             const std::vector<std::vector<unsigned char>> &aads)
+    {
+        if (keys.size() != in.size() || ivs.size() != in.size() ||
+            (!aads.empty() && aads.size() != in.size()))
         {
-            EVP_CIPHER_CTX_cleanup(ctx);
-            throw std::runtime_error("EVP_DecryptUpdate()");
+            throw std::runtime_error("IllegalArgumentException");
         }
-
-        if (EVP_DecryptFinal_ex(ctx, out_buf, &out_len) != 1)
+        std::vector<std::vector<unsigned char>> out;
+        out.reserve(in.size());
+        AesGcm &gcm = threadCipher();
+        static const std::vector<unsigned char> no_aad;
+        for (size_t i = 0; i < in.size(); i++)
         {
-            EVP_CIPHER_CTX_cleanup(ctx);
-            throw std::runtime_error("EVP_DecryptFinal_ex()");
+            if (i == 0 || keys[i] != keys[i - 1])
+            {
+                gcm.setKey(keys[i]);
+            }
+            const std::vector<unsigned char> &aad =
+                aads.empty() ? no_aad : aads[i];
+            out.push_back(encrypt ? gcm.encrypt(in[i], ivs[i], aad)
+                                  : gcm.decrypt(in[i], ivs[i], aad));
         }
-        std::vector<unsigned char> plaintext(out_buf, out_buf + out_len);
-        return plaintext;
+        return out;
     }
 };
 #endif
\ No newline at end of file
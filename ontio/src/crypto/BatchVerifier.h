@@ -0,0 +1,131 @@
+#ifndef BATCHVERIFIER_H
+#define BATCHVERIFIER_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/ThreadPool.h"
+#include "Curve.h"
+#include "ECKey.h"
+#include "KeyType.hpp"
+#include "SignatureHandler.h"
+
+// one (public key, digest, signature) triple. publicKey is an encoded EC
+// point or a serialized Ed25519 key, signature is r || s or R || S,
+// optionally prefixed by its scheme byte as Signature::toBytes writes it.
+struct VerifyItem {
+  std::vector<unsigned char> publicKey;
+  std::vector<unsigned char> digest;
+  std::vector<unsigned char> signature;
+};
+
+// Verifies ECDSA signatures over already hashed messages in parallel.
+// Decoded public keys are cached, so a block signed by a handful of
+// bookkeepers decodes each key once.
+class BatchVerifier {
+private:
+  CurveName curveName;
+  size_t cacheCapacity;
+  std::unordered_map<std::string, ECKey> keyCache;
+  std::mutex cacheMutex;
+  ThreadPool pool;
+
+  // a key that fails to decode is cached as empty and never verifies
+  ECKey getKey(const std::vector<unsigned char> &public_key) {
+    std::string id(public_key.begin(), public_key.end());
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      std::unordered_map<std::string, ECKey>::const_iterator it =
+          keyCache.find(id);
+      if (it != keyCache.end()) {
+        return it->second;
+      }
+    }
+    ECKey key;
+    try {
+      if (public_key.size() == 34 &&
+          public_key[0] == KeyTypeMethod::getLabel(KeyType::EDDSA)) {
+        key = ECKey::fromPublicKey(public_key.data() + 2, 32,
+                                   CurveName::ED25519);
+      } else {
+        key = ECKey::fromPublicKey(public_key.data(), public_key.size(),
+                                   curveName);
+      }
+    } catch (const std::runtime_error &) {
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (keyCache.size() >= cacheCapacity && !keyCache.empty()) {
+      keyCache.erase(keyCache.begin());
+    }
+    keyCache[id] = key;
+    return key;
+  }
+
+  bool verifyItem(const VerifyItem &item) {
+    ECKey key = getKey(item.publicKey);
+    std::vector<unsigned char> rs;
+    if (item.signature.size() % 2 != 0) {
+      rs.assign(item.signature.begin() + 1, item.signature.end());
+    }
+    const std::vector<unsigned char> &sig =
+        item.signature.size() % 2 == 0 ? item.signature : rs;
+    if (key.isEd25519()) {
+      return SignatureHandler::EDDSA_verify(key, item.digest.data(),
+                                            item.digest.size(), sig);
+    }
+    return SignatureHandler::ECDSA_verify_digest(key, item.digest, sig);
+  }
+
+public:
+  // threads == 0 uses one worker per hardware thread
+  explicit BatchVerifier(size_t threads = 0,
+                         CurveName curve_name = CurveName::p256,
+                         size_t cache_capacity = 4096)
+      : curveName(curve_name), cacheCapacity(cache_capacity), pool(threads) {}
+
+  bool verify(const VerifyItem &item) { return verifyItem(item); }
+
+  // result[i] tells whether items[i] carries a valid signature
+  std::vector<bool> verify(const std::vector<VerifyItem> &items) {
+    std::vector<unsigned char> valid(items.size(), 0);
+    // a few chunks per worker keeps them busy when item costs differ
+    size_t chunks = std::min(items.size(), pool.size() * 4);
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks);
+    for (size_t c = 0; c < chunks; c++) {
+      size_t begin = items.size() * c / chunks;
+      size_t end = items.size() * (c + 1) / chunks;
+      futures.push_back(pool.submit([this, &items, &valid, begin, end]() {
+        for (size_t i = begin; i < end; i++) {
+          valid[i] = verifyItem(items[i]) ? 1 : 0;
+        }
+      }));
+    }
+    // every task must finish before items and valid go out of scope
+    for (size_t c = 0; c < futures.size(); c++) {
+      futures[c].wait();
+    }
+    for (size_t c = 0; c < futures.size(); c++) {
+      futures[c].get();
+    }
+    return std::vector<bool>(valid.begin(), valid.end());
+  }
+
+  size_t threads() const { return pool.size(); }
+
+  size_t cachedKeys() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return keyCache.size();
+  }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef CURVEREGISTRY_H
+#define CURVEREGISTRY_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <openssl/ec.h>
+
+#include "Curve.h"
+
+// Process wide EC_GROUPs, one per curve, built with their generator
+// multiples precomputed the first time the curve is asked for and never
+// modified afterwards. OpenSSL only reads a const EC_GROUP, so the groups
+// are shared by every thread. EC_KEYs made by newKey() copy the group,
+// which shares the precomputed table by reference count.
+class CurveRegistry
+{
+private:
+  typedef std::unique_ptr<EC_GROUP, void (*)(EC_GROUP *)> GroupPtr;
+
+  std::mutex mutex;
+  std::map<CurveName, GroupPtr> groups;
+
+  CurveRegistry() {}
+
+  static CurveRegistry &instance()
+  {
+    static CurveRegistry registry;
+    return registry;
+  }
+
+  const EC_GROUP *find(CurveName curve_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<CurveName, GroupPtr>::const_iterator it = groups.find(curve_name);
+    if (it != groups.end())
+    {
+      return it->second.get();
+    }
+    if (curve_name == CurveName::ED25519)
+    {
+      throw std::runtime_error("Ed25519 has no EC_GROUP");
+    }
+    GroupPtr group(
+        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curve_name)),
+        EC_GROUP_free);
+    if (!group)
+    {
+      throw std::runtime_error("unknown curve");
+    }
+    // a curve without a precomputed table still works, only slower
+    EC_GROUP_precompute_mult(group.get(), NULL);
+    const EC_GROUP *result = group.get();
+    groups.insert(std::make_pair(curve_name, std::move(group)));
+    return result;
+  }
+
+public:
+  CurveRegistry(const CurveRegistry &) = delete;
+  CurveRegistry &operator=(const CurveRegistry &) = delete;
+
+  // owned by the registry, valid until the process exits
+  static const EC_GROUP *group(CurveName curve_name)
+  {
+    return instance().find(curve_name);
+  }
+
+  // an empty EC_KEY on the shared group of curve_name, for the caller to
+  // free with EC_KEY_free
+  static EC_KEY *newKey(CurveName curve_name)
+  {
+    const EC_GROUP *ec_group = group(curve_name);
+    EC_KEY *ec_key = EC_KEY_new();
+    if (ec_key == NULL || EC_KEY_set_group(ec_key, ec_group) != 1)
+    {
+      EC_KEY_free(ec_key);
+      throw std::runtime_error("EC_KEY_set_group() failed!");
+    }
+    return ec_key;
+  }
+};
+
+#endif
@@ -5,85 +5,201 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <stddef.h>
+#include <string.h>
+
+#include <array>
 #include <vector>
 
 #include <openssl/ripemd.h>
 #include <openssl/sha.h>
 
+#include "Sha256Batch.h"
+
 #if defined(WIN32) || defined(_WIN64)
 #pragma comment(lib, "libeay32.lib")
 #pragma comment(lib, "ssleay32.lib")
 #endif
 
+// Incremental SHA-256 on a stack-allocated context:
+//   Sha256Context ctx;
+//   ctx.update(header, header_len).update(body, body_len);
+//   Digest::Hash256 h = ctx.final();
+// init() resets the context so one instance can hash many messages.
+class Sha256Context
+{
+private:
+  SHA256_CTX ctx;
+
+public:
+  Sha256Context() { init(); }
+
+  void init() { SHA256_Init(&ctx); }
+
+  Sha256Context &update(const unsigned char *data, size_t len)
+  {
+    SHA256_Update(&ctx, data, len);
+    return *this;
+  }
+
+  Sha256Context &update(const std::vector<unsigned char> &data)
+  {
+    return update(data.data(), data.size());
+  }
+
+  void final(unsigned char *out) { SHA256_Final(out, &ctx); }
+
+  std::array<unsigned char, SHA256_DIGEST_LENGTH> final()
+  {
+    std::array<unsigned char, SHA256_DIGEST_LENGTH> out;
+    final(out.data());
+    return out;
+  }
+
+  // sha256 of the digest, i.e. hash256 of everything fed to update()
+  std::array<unsigned char, SHA256_DIGEST_LENGTH> finalHash256()
+  {
+    std::array<unsigned char, SHA256_DIGEST_LENGTH> out;
+    final(out.data());
+    init();
+    update(out.data(), out.size());
+    final(out.data());
+    return out;
+  }
+};
+
 class Digest
 {
 public:
+  typedef std::array<unsigned char, SHA256_DIGEST_LENGTH> Hash256;
+  typedef std::array<unsigned char, RIPEMD160_DIGEST_LENGTH> Hash160;
+
+  static Hash256 sha256(const unsigned char *data, size_t len)
+  {
+    return Sha256Context().update(data, len).final();
+  }
+
+  static Hash256 hash256(const unsigned char *data, size_t len)
+  {
+    return Sha256Context().update(data, len).finalHash256();
+  }
+
+  static Hash160 hash160(const unsigned char *data, size_t len)
+  {
+    Hash256 sha256_uc = sha256(data, len);
+    Hash160 out;
+    RIPEMD160_CTX ripemd160_ctx;
+    RIPEMD160_Init(&ripemd160_ctx);
+    RIPEMD160_Update(&ripemd160_ctx, sha256_uc.data(), sha256_uc.size());
+    RIPEMD160_Final(out.data(), &ripemd160_ctx);
+    return out;
+  }
+
+  // hash256 of every message, see Sha256Batch for how lanes are used
+  static std::vector<Hash256>
+  hash256Batch(const std::vector<std::vector<unsigned char>> &messages,
+               Sha256Impl impl = Sha256Impl::AUTO)
+  {
+    std::vector<const unsigned char *> data(messages.size());
+    std::vector<size_t> lens(messages.size());
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+      data[i] = messages[i].data();
+      lens[i] = messages[i].size();
+    }
+    std::vector<Hash256> out(messages.size());
+    Sha256Batch::hash256(data.data(), lens.data(), messages.size(),
+                         out.empty() ? nullptr : out[0].data(), impl);
+    return out;
+  }
+
+  // Ontology's TransactionsRoot: pairs are hashed with hash256, an odd node
+  // is paired with itself. Leaves are hash256 outputs as they come out of
+  // the hash, not the byte reversed form Inventory::hash() returns.
+  static Hash256 merkleRoot(std::vector<Hash256> hashes,
+                            Sha256Impl impl = Sha256Impl::AUTO)
+  {
+    if (hashes.empty())
+    {
+      return Hash256();
+    }
+    std::vector<unsigned char> pairs;
+    std::vector<const unsigned char *> data;
+    std::vector<size_t> lens;
+    while (hashes.size() > 1)
+    {
+      size_t n = (hashes.size() + 1) / 2;
+      pairs.resize(64 * n);
+      data.resize(n);
+      lens.assign(n, 64);
+      for (size_t i = 0; i < n; i++)
+      {
+        const Hash256 &right =
+            2 * i + 1 < hashes.size() ? hashes[2 * i + 1] : hashes[2 * i];
+        memcpy(&pairs[64 * i], hashes[2 * i].data(), 32);
+        memcpy(&pairs[64 * i + 32], right.data(), 32);
+        data[i] = &pairs[64 * i];
+      }
+      hashes.resize(n);
+      Sha256Batch::hash256(data.data(), lens.data(), n, hashes[0].data(),
+                           impl);
+    }
+    return hashes[0];
+  }
+
   static std::vector<unsigned char>
   sha256(const std::vector<unsigned char> &value)
   {
-    unsigned char sha256_uc[SHA256_DIGEST_LENGTH];
-    SHA256_CTX sha256_ctx;
-    SHA256_Init(&sha256_ctx);
-    SHA256_Update(&sha256_ctx, (unsigned char *)(&value[0]), value.size());
-    SHA256_Final(sha256_uc, &sha256_ctx);
-    std::vector<unsigned char> uc_vec(&sha256_uc[0],
-                                      &sha256_uc[SHA256_DIGEST_LENGTH]);
-    return uc_vec;
+    Hash256 sha256_uc = sha256(value.data(), value.size());
+    return std::vector<unsigned char>(sha256_uc.begin(), sha256_uc.end());
   }
 
   static std::vector<unsigned char>
   sha256(const std::vector<unsigned char> &value, int offset, int length)
   {
-    if (offset + length > int(value.size()))
+    if (offset < 0 || length < 0 || offset + length > int(value.size()))
     {
       throw "Error offset and length";
     }
-    std::vector<unsigned char> array;
-    array = value;
-    if (offset != 0 || length != int(value.size()))
-    {
-      array.clear();
-      array.assign(value.begin() + offset, value.begin() + offset + length);
-    }
-    return sha256(array);
+    Hash256 sha256_uc = sha256(value.data() + offset, length);
+    return std::vector<unsigned char>(sha256_uc.begin(), sha256_uc.end());
   }
 
   static std::vector<unsigned char>
-  ripemd160(std::vector<unsigned char> &value)
+  ripemd160(const std::vector<unsigned char> &value)
   {
     unsigned char ripemd160_uc[RIPEMD160_DIGEST_LENGTH];
     RIPEMD160_CTX ripemd160_ctx;
     RIPEMD160_Init(&ripemd160_ctx);
-    RIPEMD160_Update(&ripemd160_ctx, (unsigned char *)(&value[0]),
-                     value.size());
+    RIPEMD160_Update(&ripemd160_ctx, value.data(), value.size());
     RIPEMD160_Final(ripemd160_uc, &ripemd160_ctx);
-    std::vector<unsigned char> uc_vec;
-    uc_vec.assign(&ripemd160_uc[0], &ripemd160_uc[RIPEMD160_DIGEST_LENGTH]);
-    return uc_vec;
+    return std::vector<unsigned char>(ripemd160_uc,
+                                      ripemd160_uc + RIPEMD160_DIGEST_LENGTH);
   }
 
   static std::vector<unsigned char>
   hash160(const std::vector<unsigned char> &value)
   {
-    std::vector<unsigned char> sha256_vec;
-    sha256_vec = sha256(value);
-    return ripemd160(sha256_vec);
+    Hash160 hash160_uc = hash160(value.data(), value.size());
+    return std::vector<unsigned char>(hash160_uc.begin(), hash160_uc.end());
   }
 
   static std::vector<unsigned char>
   hash256(const std::vector<unsigned char> &value)
   {
-    std::vector<unsigned char> sha256_vec;
-    sha256_vec = sha256(value);
-    return sha256(sha256_vec);
+    Hash256 hash256_uc = hash256(value.data(), value.size());
+    return std::vector<unsigned char>(hash256_uc.begin(), hash256_uc.end());
   }
 
   static std::vector<unsigned char>
   hash256(const std::vector<unsigned char> &value, int offset, int length)
   {
-    std::vector<unsigned char> sha256_vec;
-    sha256_vec = sha256(value, offset, length);
-    return sha256(sha256_vec);
+    if (offset < 0 || length < 0 || offset + length > int(value.size()))
+    {
+      throw "Error offset and length";
+    }
+    Hash256 hash256_uc = hash256(value.data() + offset, length);
+    return std::vector<unsigned char>(hash256_uc.begin(), hash256_uc.end());
   }
 };
 #endif
\ No newline at end of file
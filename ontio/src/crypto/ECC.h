@@ -34,14 +34,37 @@ public:
     sm2p256v1 = new ECDomainParameters(CurveName::SM2P256V1);
   }
 
+  ECC(const ECC &ecc)
+  {
+    secp256r1 = new ECDomainParameters(*ecc.secp256r1);
+    sm2p256v1 = new ECDomainParameters(*ecc.sm2p256v1);
+  }
+
+  ECC &operator=(const ECC &ecc)
+  {
+    *secp256r1 = *ecc.secp256r1;
+    *sm2p256v1 = *ecc.sm2p256v1;
+    return *this;
+  }
+
+  ~ECC()
+  {
+    delete secp256r1;
+    delete sm2p256v1;
+  }
+
   static std::vector<unsigned char> generateKey(int len)
   {
-    unsigned char key[len];
-    if (RAND_bytes(key, len) != 1)
+    if (len < 0)
+    {
+      throw std::runtime_error("generateKey: negative length");
+    }
+    std::vector<unsigned char> key((size_t)len);
+    if (len > 0 && RAND_bytes(key.data(), len) != 1)
     {
       throw std::runtime_error("BAND_bytes() fail.");
     }
-    return std::vector<unsigned char>(key, key + len);
+    return key;
   }
 
   static std::vector<unsigned char> generateKey()
@@ -5,12 +5,16 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include <openssl/bn.h>
 #include <openssl/ec.h>
-#include <string>
 
 #include "Curve.h"
+#include "CurveRegistry.h"
 
 #if defined(WIN32) || defined(_WIN64)
 #pragma comment(lib, "libeay32.lib")
@@ -21,37 +25,45 @@ class ECDomainParameters {
 private:
   CurveName curve_name;
   EC_POINT *ec_point;
-  EC_GROUP *group;
+  // shared with every other user of the curve, see CurveRegistry
+  const EC_GROUP *group;
 
 public:
-  ECDomainParameters() {}
-  ECDomainParameters(CurveName curve) : curve_name(curve) {
-    group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curve_name));
+  ECDomainParameters() : ec_point(NULL), group(NULL) {}
+  ECDomainParameters(CurveName curve)
+      : curve_name(curve), group(CurveRegistry::group(curve)) {
     ec_point = EC_POINT_new(group);
   }
 
-  ~ECDomainParameters() {
-    EC_POINT_free(ec_point);
-    EC_GROUP_free(group);
-  }
+  ECDomainParameters(const ECDomainParameters &param)
+      : curve_name(param.curve_name),
+        ec_point(param.ec_point == NULL
+                     ? NULL
+                     : EC_POINT_dup(param.ec_point, param.group)),
+        group(param.group) {}
+
+  ~ECDomainParameters() { EC_POINT_free(ec_point); }
 
   ECDomainParameters &operator=(const ECDomainParameters &param) {
-    this->curve_name = param.curve_name;
-    this->ec_point = param.ec_point;
-    this->group = param.group;
+    if (this != &param) {
+      EC_POINT_free(this->ec_point);
+      this->curve_name = param.curve_name;
+      this->group = param.group;
+      this->ec_point = param.ec_point == NULL
+                           ? NULL
+                           : EC_POINT_dup(param.ec_point, param.group);
+    }
     return *this;
   }
 
   void set_EC_Point(const std::string &pubkey) {
+    EC_POINT_free(ec_point);
     ec_point = EC_POINT_hex2point(group, pubkey.c_str(), nullptr, nullptr);
   }
 
+  // the caller frees the point with EC_POINT_free
   EC_POINT *convert_EC_Point(const std::string &pubkey) {
-    EC_POINT *point;
-    point = EC_POINT_new(group);
-    point = EC_POINT_hex2point(group, pubkey.c_str(), nullptr, nullptr);
-    return point;
+    return EC_POINT_hex2point(group, pubkey.c_str(), nullptr, nullptr);
   }
 
   EC_POINT *get_EC_Point() { return ec_point; }
@@ -63,24 +75,27 @@ public:
     if (result == 0) {
       return result;
     }
-    BIGNUM *a_x = BN_new();
-    BIGNUM *a_y = BN_new();
-    BIGNUM *b_x = BN_new();
-    BIGNUM *b_y = BN_new();
-    if (!EC_POINT_get_affine_coordinates_GFp(group, a, a_x, a_y, nullptr)) {
-      throw std::runtime_error(
-          "EC_POINT_get_affine_coordinates_GFp failed.");
+    std::unique_ptr<BN_CTX, void (*)(BN_CTX *)> ctx(BN_CTX_new(), BN_CTX_free);
+    if (!ctx) {
+      throw std::runtime_error("BN_CTX_new failed.");
     }
-    if (!EC_POINT_get_affine_coordinates_GFp(group, b, b_x, b_y, nullptr)) {
+    BN_CTX_start(ctx.get());
+    BIGNUM *a_x = BN_CTX_get(ctx.get());
+    BIGNUM *a_y = BN_CTX_get(ctx.get());
+    BIGNUM *b_x = BN_CTX_get(ctx.get());
+    BIGNUM *b_y = BN_CTX_get(ctx.get());
+    if (b_y == NULL ||
+        !EC_POINT_get_affine_coordinates_GFp(group, a, a_x, a_y, ctx.get()) ||
+        !EC_POINT_get_affine_coordinates_GFp(group, b, b_x, b_y, ctx.get())) {
+      BN_CTX_end(ctx.get());
       throw std::runtime_error(
           "EC_POINT_get_affine_coordinates_GFp failed.");
     }
-    EC_GROUP_free(group);
     result = BN_cmp(a_x, b_x);
-    if (result != 0) {
-      return result;
+    if (result == 0) {
+      result = BN_cmp(a_y, b_y);
     }
-    result = BN_cmp(a_y, b_y);
+    BN_CTX_end(ctx.get());
     return result;
   }
 
@@ -89,8 +104,12 @@ public:
   std::string
   toString(EC_POINT *p,
            point_conversion_form_t from = POINT_CONVERSION_UNCOMPRESSED) {
-    std::string str_p;
-    str_p = EC_POINT_point2hex(group, p, from, nullptr);
+    char *hex = EC_POINT_point2hex(group, p, from, nullptr);
+    if (hex == NULL) {
+      throw std::runtime_error("EC_POINT_point2hex failed.");
+    }
+    std::string str_p(hex);
+    OPENSSL_free(hex);
     return str_p;
   }
 };
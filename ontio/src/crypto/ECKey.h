@@ -0,0 +1,264 @@
+#ifndef ECKEY_H
+#define ECKEY_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+
+#include "../common/Hex.h"
+#include "Curve.h"
+#include "CurveRegistry.h"
+
+// An EC key pair parsed from its hex private key once. The EC_KEY and the
+// EVP_PKEY wrapping it are shared by reference count, so copies of an
+// Account sign with the same OpenSSL objects and nothing is parsed again.
+// Ed25519 keys have no EC_KEY, only the EVP_PKEY.
+class ECKey
+{
+private:
+  std::shared_ptr<EC_KEY> ec_key;
+  std::shared_ptr<EVP_PKEY> evp_pkey;
+
+  static const size_t ED25519_KEY_SIZE = 32;
+
+  static std::string toHex(const unsigned char *data, size_t len)
+  {
+    std::string hex(2 * len, '0');
+    Hex::encode(data, len, &hex[0]);
+    return hex;
+  }
+
+  void setEd25519(EVP_PKEY *pkey)
+  {
+    if (pkey == NULL)
+    {
+      throw std::runtime_error("EVP_PKEY_new_raw_key() failed!");
+    }
+    evp_pkey.reset(pkey, EVP_PKEY_free);
+  }
+
+  void setEvpPkey()
+  {
+    evp_pkey.reset(EVP_PKEY_new(), EVP_PKEY_free);
+    if (!evp_pkey || EVP_PKEY_set1_EC_KEY(evp_pkey.get(), ec_key.get()) != 1)
+    {
+      throw std::runtime_error("EVP_PKEY_set1_EC_KEY() failed!");
+    }
+  }
+
+public:
+  ECKey() {}
+
+  ECKey(const std::string &str_private_key, CurveName curve_name)
+  {
+    if (curve_name == CurveName::ED25519)
+    {
+      unsigned char raw[ED25519_KEY_SIZE];
+      if (str_private_key.size() != 2 * ED25519_KEY_SIZE ||
+          !Hex::decode(str_private_key.data(), ED25519_KEY_SIZE, raw))
+      {
+        throw std::runtime_error("Ed25519 private key must be 32 hex bytes");
+      }
+      setEd25519(EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, raw,
+                                              ED25519_KEY_SIZE));
+      OPENSSL_cleanse(raw, sizeof(raw));
+      return;
+    }
+    ec_key.reset(CurveRegistry::newKey(curve_name), EC_KEY_free);
+    BIGNUM *prv = NULL;
+    if (BN_hex2bn(&prv, str_private_key.c_str()) == 0)
+    {
+      throw std::runtime_error("BN_hex2bn() failed!");
+    }
+    const EC_GROUP *group = EC_KEY_get0_group(ec_key.get());
+    EC_POINT *pub = EC_POINT_new(group);
+    bool ok = pub != NULL &&
+              EC_KEY_set_private_key(ec_key.get(), prv) == 1 &&
+              EC_POINT_mul(group, pub, prv, NULL, NULL, NULL) == 1 &&
+              EC_KEY_set_public_key(ec_key.get(), pub) == 1;
+    EC_POINT_free(pub);
+    BN_clear_free(prv);
+    if (!ok)
+    {
+      throw std::runtime_error("EC_KEY_set_public_key() failed!");
+    }
+    setEvpPkey();
+  }
+
+  // a fresh random key pair
+  static ECKey generate(CurveName curve_name)
+  {
+    ECKey key;
+    if (curve_name == CurveName::ED25519)
+    {
+      EVP_PKEY *pkey = NULL;
+      EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
+      bool ok = pctx != NULL && EVP_PKEY_keygen_init(pctx) == 1 &&
+                EVP_PKEY_keygen(pctx, &pkey) == 1;
+      EVP_PKEY_CTX_free(pctx);
+      if (!ok)
+      {
+        throw std::runtime_error("EVP_PKEY_keygen() failed!");
+      }
+      key.setEd25519(pkey);
+      return key;
+    }
+    key.ec_key.reset(CurveRegistry::newKey(curve_name), EC_KEY_free);
+    if (EC_KEY_generate_key(key.ec_key.get()) != 1)
+    {
+      throw std::runtime_error("EC_KEY_generate_key() failed!");
+    }
+    key.setEvpPkey();
+    return key;
+  }
+
+  // verify-only key from an encoded point, compressed or not, or from the
+  // 32 raw bytes of an Ed25519 public key
+  static ECKey fromPublicKey(const unsigned char *data, size_t len,
+                             CurveName curve_name)
+  {
+    ECKey key;
+    if (curve_name == CurveName::ED25519)
+    {
+      if (len != ED25519_KEY_SIZE)
+      {
+        throw std::runtime_error("Ed25519 public key must be 32 bytes");
+      }
+      key.setEd25519(
+          EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, data, len));
+      return key;
+    }
+    key.ec_key.reset(CurveRegistry::newKey(curve_name), EC_KEY_free);
+    if (EC_KEY_oct2key(key.ec_key.get(), data, len, NULL) != 1)
+    {
+      throw std::runtime_error("EC_KEY_oct2key() failed!");
+    }
+    key.setEvpPkey();
+    return key;
+  }
+
+  static ECKey fromPublicKeyHex(const std::string &str_public_key,
+                                CurveName curve_name)
+  {
+    if (curve_name == CurveName::ED25519)
+    {
+      unsigned char raw[ED25519_KEY_SIZE];
+      if (str_public_key.size() != 2 * ED25519_KEY_SIZE ||
+          !Hex::decode(str_public_key.data(), ED25519_KEY_SIZE, raw))
+      {
+        throw std::runtime_error("Ed25519 public key must be 32 hex bytes");
+      }
+      return fromPublicKey(raw, ED25519_KEY_SIZE, curve_name);
+    }
+    EC_POINT *pub = EC_POINT_hex2point(CurveRegistry::group(curve_name),
+                                       str_public_key.c_str(), NULL, NULL);
+    if (pub == NULL)
+    {
+      throw std::runtime_error("EC_POINT_hex2point() failed!");
+    }
+    ECKey key;
+    try
+    {
+      key.ec_key.reset(CurveRegistry::newKey(curve_name), EC_KEY_free);
+    }
+    catch (...)
+    {
+      EC_POINT_free(pub);
+      throw;
+    }
+    bool ok = EC_KEY_set_public_key(key.ec_key.get(), pub) == 1;
+    EC_POINT_free(pub);
+    if (!ok)
+    {
+      throw std::runtime_error("EC_KEY_set_public_key() failed!");
+    }
+    key.setEvpPkey();
+    return key;
+  }
+
+  bool empty() const { return !evp_pkey; }
+
+  bool isEd25519() const
+  {
+    return evp_pkey && EVP_PKEY_id(evp_pkey.get()) == EVP_PKEY_ED25519;
+  }
+
+  // NULL for Ed25519 keys
+  EC_KEY *get() const { return ec_key.get(); }
+
+  EVP_PKEY *getEvpPkey() const { return evp_pkey.get(); }
+
+  // the private scalar, zero padded to the size of the group order, or the
+  // 32 byte Ed25519 seed
+  std::string getPrivateKeyHex() const
+  {
+    if (isEd25519())
+    {
+      unsigned char raw[ED25519_KEY_SIZE];
+      size_t len = sizeof(raw);
+      if (EVP_PKEY_get_raw_private_key(evp_pkey.get(), raw, &len) != 1)
+      {
+        throw std::runtime_error("EVP_PKEY_get_raw_private_key() failed!");
+      }
+      std::string hex = toHex(raw, len);
+      OPENSSL_cleanse(raw, sizeof(raw));
+      return hex;
+    }
+    if (!ec_key || EC_KEY_get0_private_key(ec_key.get()) == NULL)
+    {
+      throw std::runtime_error("EC_KEY has no private key");
+    }
+    const EC_GROUP *group = EC_KEY_get0_group(ec_key.get());
+    std::vector<unsigned char> raw((EC_GROUP_order_bits(group) + 7) / 8);
+    if (BN_bn2binpad(EC_KEY_get0_private_key(ec_key.get()), raw.data(),
+                     (int)raw.size()) != (int)raw.size())
+    {
+      throw std::runtime_error("BN_bn2binpad() failed!");
+    }
+    std::string hex = toHex(raw.data(), raw.size());
+    OPENSSL_cleanse(raw.data(), raw.size());
+    return hex;
+  }
+
+  // an EC point in the given form, or the 32 raw bytes of an Ed25519 key
+  std::string getPublicKeyHex(
+      point_conversion_form_t form = POINT_CONVERSION_COMPRESSED) const
+  {
+    if (empty())
+    {
+      throw std::runtime_error("EC_KEY is NULL");
+    }
+    if (isEd25519())
+    {
+      unsigned char raw[ED25519_KEY_SIZE];
+      size_t len = sizeof(raw);
+      if (EVP_PKEY_get_raw_public_key(evp_pkey.get(), raw, &len) != 1)
+      {
+        throw std::runtime_error("EVP_PKEY_get_raw_public_key() failed!");
+      }
+      return toHex(raw, len);
+    }
+    char *hex = EC_POINT_point2hex(EC_KEY_get0_group(ec_key.get()),
+                                   EC_KEY_get0_public_key(ec_key.get()), form,
+                                   NULL);
+    if (hex == NULL)
+    {
+      throw std::runtime_error("EC_POINT_point2hex() failed!");
+    }
+    std::string publicKey(hex);
+    OPENSSL_free(hex);
+    return publicKey;
+  }
+};
+
+#endif
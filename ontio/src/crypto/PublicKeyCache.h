@@ -0,0 +1,209 @@
+#ifndef PUBLICKEYCACHE_H
+#define PUBLICKEYCACHE_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+
+#include "../common/Hex.h"
+#include "Curve.h"
+#include "CurveRegistry.h"
+#include "KeyType.hpp"
+
+// A serialized public key reduced to what multisig ordering compares: the
+// key type label, then the affine x and y, big endian and zero padded to
+// the field size. Ed25519 keys keep their 32 raw bytes in x.
+struct DecodedPublicKey
+{
+  int label;
+  std::vector<unsigned char> x;
+  std::vector<unsigned char> y;
+
+  DecodedPublicKey() : label(0) {}
+
+  int compare(const DecodedPublicKey &other) const
+  {
+    if (label != other.label)
+    {
+      return label < other.label ? -1 : 1;
+    }
+    if (x != other.x)
+    {
+      return x < other.x ? -1 : 1;
+    }
+    if (y != other.y)
+    {
+      return y < other.y ? -1 : 1;
+    }
+    return 0;
+  }
+};
+
+// LRU cache of decoded public keys keyed by their hex encoding. Sorting
+// the keys of a multisig program decodes each point once instead of on
+// every comparison, and the same bookkeeper keys are decoded once across
+// programs. Safe to share between threads.
+class PublicKeyCache
+{
+private:
+  typedef std::pair<std::string, DecodedPublicKey> Entry;
+
+  size_t capacity;
+  // most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index;
+  std::mutex mutex;
+
+  static CurveName curveFromLabel(unsigned char label)
+  {
+    switch (label)
+    {
+    case 1:
+      return CurveName::p224;
+    case 2:
+      return CurveName::p256;
+    case 3:
+      return CurveName::p384;
+    case 4:
+      return CurveName::p521;
+    case 20:
+      return CurveName::SM2P256V1;
+    default:
+      throw std::runtime_error("unknown curve label in public key");
+    }
+  }
+
+  static void decodePoint(CurveName curve_name, const unsigned char *data,
+                          size_t len, DecodedPublicKey &key)
+  {
+    const EC_GROUP *group = CurveRegistry::group(curve_name);
+    std::unique_ptr<EC_POINT, void (*)(EC_POINT *)> point(EC_POINT_new(group),
+                                                          EC_POINT_free);
+    std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> x(BN_new(), BN_free);
+    std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> y(BN_new(), BN_free);
+    if (!point || !x || !y ||
+        EC_POINT_oct2point(group, point.get(), data, len, NULL) != 1 ||
+        EC_POINT_get_affine_coordinates_GFp(group, point.get(), x.get(),
+                                            y.get(), NULL) != 1)
+    {
+      throw std::runtime_error("invalid EC point in public key");
+    }
+    size_t field_size = (EC_GROUP_get_degree(group) + 7) / 8;
+    key.x.resize(field_size);
+    key.y.resize(field_size);
+    BN_bn2binpad(x.get(), key.x.data(), (int)field_size);
+    BN_bn2binpad(y.get(), key.y.data(), (int)field_size);
+  }
+
+public:
+  static const size_t DEFAULT_CAPACITY = 1024;
+
+  explicit PublicKeyCache(size_t _capacity = DEFAULT_CAPACITY)
+      : capacity(_capacity == 0 ? 1 : _capacity) {}
+
+  PublicKeyCache(const PublicKeyCache &) = delete;
+  PublicKeyCache &operator=(const PublicKeyCache &) = delete;
+
+  // the process wide cache Program sorts through
+  static PublicKeyCache &shared()
+  {
+    static PublicKeyCache cache;
+    return cache;
+  }
+
+  // hex_key is a bare compressed or uncompressed P-256 point, or a point
+  // prefixed by its key type and curve labels, with or without "0x"
+  static DecodedPublicKey decode(const std::string &hex_key)
+  {
+    size_t offset = 0;
+    if (hex_key.size() >= 2 && hex_key[0] == '0' &&
+        (hex_key[1] == 'x' || hex_key[1] == 'X'))
+    {
+      offset = 2;
+    }
+    size_t len = (hex_key.size() - offset) / 2;
+    std::vector<unsigned char> data(len);
+    if ((hex_key.size() - offset) % 2 != 0 || len < 2 ||
+        !Hex::decode(hex_key.data() + offset, len, data.data()))
+    {
+      throw std::runtime_error("public key is not a hex string");
+    }
+    DecodedPublicKey key;
+    if ((len == 33 && (data[0] == 0x02 || data[0] == 0x03)) ||
+        (len == 65 && data[0] == 0x04))
+    {
+      key.label = KeyTypeMethod::getLabel(KeyType::ECDSA);
+      decodePoint(CurveName::p256, data.data(), len, key);
+      return key;
+    }
+    key.label = data[0];
+    switch (data[0])
+    {
+    case 0x12:
+    case 0x13:
+      decodePoint(curveFromLabel(data[1]), data.data() + 2, len - 2, key);
+      break;
+    case 0x14:
+      key.x.assign(data.begin() + 2, data.end());
+      break;
+    default:
+      throw std::runtime_error("unknown key type label in public key");
+    }
+    return key;
+  }
+
+  DecodedPublicKey get(const std::string &hex_key)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::unordered_map<std::string, std::list<Entry>::iterator>::iterator
+          it = index.find(hex_key);
+      if (it != index.end())
+      {
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+      }
+    }
+    // decode outside the lock, a racing thread at worst decodes it twice
+    DecodedPublicKey key = decode(hex_key);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(hex_key) == index.end())
+    {
+      entries.push_front(Entry(hex_key, key));
+      index[hex_key] = entries.begin();
+      if (entries.size() > capacity)
+      {
+        index.erase(entries.back().first);
+        entries.pop_back();
+      }
+    }
+    return key;
+  }
+
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+  }
+};
+
+#endif
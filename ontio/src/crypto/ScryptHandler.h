@@ -1,8 +1,12 @@
 #ifndef CRYPTO_SCRYPTHANDLER_H
 #define CRYPTO_SCRYPTHANDLER_H
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <openssl/evp.h>
 #include <openssl/kdf.h>
@@ -51,43 +55,59 @@ class ScryptHandler
     scrypt(const std::string &password, const std::vector<unsigned char> &salt,
            int n = 16384, int r = 8, int p = 8, int dkLen = 64)
     {
-        EVP_PKEY_CTX *pctx;
-        unsigned char derivedkey[dkLen];
-
-        size_t outlen = sizeof(derivedkey);
-        pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_SCRYPT, nullptr);
-
-        if (!EVP_PKEY_derive_init(pctx))
+        if (n <= 1 || r <= 0 || p <= 0 || dkLen <= 0)
+        {
+            throw new SDKException(ErrorCode::ParamError);
+        }
+        std::unique_ptr<EVP_PKEY_CTX, void (*)(EVP_PKEY_CTX *)> pctx(
+            EVP_PKEY_CTX_new_id(EVP_PKEY_SCRYPT, nullptr), EVP_PKEY_CTX_free);
+        if (!pctx || !EVP_PKEY_derive_init(pctx.get()))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_CTX_set1_pbe_pass(pctx, password.c_str(),
+        if (!EVP_PKEY_CTX_set1_pbe_pass(pctx.get(), password.c_str(),
                                         password.length()))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_CTX_set1_scrypt_salt(pctx, salt.data(), (int)salt.size()))
+        if (!EVP_PKEY_CTX_set1_scrypt_salt(pctx.get(), salt.data(),
+                                           (int)salt.size()))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_CTX_set_scrypt_N(pctx, n))
+        if (!EVP_PKEY_CTX_set_scrypt_N(pctx.get(), n))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_CTX_set_scrypt_r(pctx, r))
+        if (!EVP_PKEY_CTX_set_scrypt_r(pctx.get(), r))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_CTX_set_scrypt_p(pctx, p))
+        if (!EVP_PKEY_CTX_set_scrypt_p(pctx.get(), p))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        if (!EVP_PKEY_derive(pctx, derivedkey, &outlen))
+        // OpenSSL refuses anything over 32 MiB unless told otherwise
+        if (!EVP_PKEY_CTX_set_scrypt_maxmem_bytes(
+                pctx.get(), std::max<uint64_t>(32 * 1024 * 1024,
+                                               2 * memoryCost(n, r, p))))
         {
             throw new SDKException(ErrorCode::ParamError);
         }
-        std::vector<unsigned char> vec_dk(derivedkey, derivedkey + outlen);
-        return vec_dk;
+        std::vector<unsigned char> derivedkey((size_t)dkLen);
+        size_t outlen = derivedkey.size();
+        if (!EVP_PKEY_derive(pctx.get(), derivedkey.data(), &outlen))
+        {
+            throw new SDKException(ErrorCode::ParamError);
+        }
+        derivedkey.resize(outlen);
+        return derivedkey;
+    }
+
+    // 128 * N * r * p, the bytes one derivation is budgeted for
+    static uint64_t memoryCost(int n, int r, int p)
+    {
+        return (uint64_t)128 * (uint64_t)n * (uint64_t)r * (uint64_t)p;
     }
 };
 #endif
\ No newline at end of file
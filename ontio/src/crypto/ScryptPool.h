@@ -0,0 +1,154 @@
+#ifndef CRYPTO_SCRYPTPOOL_H
+#define CRYPTO_SCRYPTPOOL_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <openssl/crypto.h>
+
+#include "../common/ThreadPool.h"
+#include "ScryptHandler.h"
+
+// Runs scrypt derivations on a fixed set of worker threads. Each job is
+// charged ScryptHandler::memoryCost(n, r, p) against a memory budget and
+// waits for room before it starts, so a batch of wallet keys never asks
+// for more than the budget at once. A job larger than the whole budget
+// still runs, alone.
+class ScryptPool
+{
+  public:
+    struct Job
+    {
+        std::string password;
+        std::vector<unsigned char> salt;
+        int n;
+        int r;
+        int p;
+        int dkLen;
+
+        Job(const std::string &_password,
+            const std::vector<unsigned char> &_salt, int _n = 16384,
+            int _r = 8, int _p = 8, int _dkLen = 64)
+            : password(_password), salt(_salt), n(_n), r(_r), p(_p),
+              dkLen(_dkLen)
+        {
+        }
+    };
+
+    static const uint64_t DEFAULT_MEMORY_BUDGET = (uint64_t)512 * 1024 * 1024;
+
+  private:
+    uint64_t memoryBudget;
+    uint64_t memoryInUse;
+    std::mutex mutex;
+    std::condition_variable cond;
+    // last member, so the workers are joined before the budget goes away
+    ThreadPool pool;
+
+    void acquire(uint64_t cost)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this, cost]() {
+            return memoryInUse == 0 || memoryInUse + cost <= memoryBudget;
+        });
+        memoryInUse += cost;
+    }
+
+    void release(uint64_t cost)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            memoryInUse -= cost;
+        }
+        cond.notify_all();
+    }
+
+    std::vector<unsigned char> run(const Job &job)
+    {
+        uint64_t cost = ScryptHandler::memoryCost(job.n, job.r, job.p);
+        acquire(cost);
+        try
+        {
+            std::vector<unsigned char> key = ScryptHandler::scrypt(
+                job.password, job.salt, job.n, job.r, job.p, job.dkLen);
+            release(cost);
+            return key;
+        }
+        catch (...)
+        {
+            release(cost);
+            throw;
+        }
+    }
+
+  public:
+    // threads == 0 uses one worker per hardware thread
+    explicit ScryptPool(size_t threads = 0,
+                        uint64_t memory_budget = DEFAULT_MEMORY_BUDGET)
+        : memoryBudget(memory_budget), memoryInUse(0), pool(threads)
+    {
+    }
+
+    size_t threads() const { return pool.size(); }
+
+    uint64_t budget() const { return memoryBudget; }
+
+    std::future<std::vector<unsigned char>> derive(const Job &job)
+    {
+        return pool.submit([this, job]() { return run(job); });
+    }
+
+    // derives the key, hands it to then on the same worker and wipes it
+    // afterwards; the future holds what then returns
+    template <class F>
+    std::future<decltype(std::declval<const F &>()(
+        std::declval<std::vector<unsigned char> &>()))>
+    derive(const Job &job, F then)
+    {
+        typedef decltype(std::declval<const F &>()(
+            std::declval<std::vector<unsigned char> &>())) R;
+        return pool.submit([this, job, then]() -> R {
+            struct Wipe
+            {
+                std::vector<unsigned char> key;
+                ~Wipe() { OPENSSL_cleanse(key.data(), key.size()); }
+            } derived;
+            derived.key = run(job);
+            return then(derived.key);
+        });
+    }
+
+    // result[i] is the key derived for jobs[i]; the first failure is
+    // rethrown once every job has finished
+    std::vector<std::vector<unsigned char>>
+    deriveBatch(const std::vector<Job> &jobs)
+    {
+        std::vector<std::future<std::vector<unsigned char>>> futures;
+        futures.reserve(jobs.size());
+        for (size_t i = 0; i < jobs.size(); i++)
+        {
+            futures.push_back(derive(jobs[i]));
+        }
+        for (size_t i = 0; i < futures.size(); i++)
+        {
+            futures[i].wait();
+        }
+        std::vector<std::vector<unsigned char>> keys;
+        keys.reserve(jobs.size());
+        for (size_t i = 0; i < futures.size(); i++)
+        {
+            keys.push_back(futures[i].get());
+        }
+        return keys;
+    }
+};
+#endif
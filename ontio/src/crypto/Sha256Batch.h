@@ -0,0 +1,362 @@
+#ifndef SHA256BATCH_H
+#define SHA256BATCH_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include <openssl/sha.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256BATCH_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+enum class Sha256Impl : int
+{
+  // pick per CPU: SHA-NI -> OpenSSL, AVX2 -> 8 lanes, else OpenSSL
+  AUTO = 0,
+  // one message at a time through OpenSSL, which uses SHA-NI by itself
+  OPENSSL = 1,
+  // 8 messages per pass on AVX2, falls back to OPENSSL without AVX2
+  AVX2 = 2
+};
+
+// SHA-256 over many independent messages. The AVX2 path runs 8 messages in
+// the 8 lanes of a ymm register and refills a lane as soon as its message is
+// done, so messages of mixed length share passes. On CPUs with SHA-NI the
+// single-stream OpenSSL code is faster, which is what AUTO picks there.
+class Sha256Batch
+{
+private:
+  static const uint32_t *roundConstants()
+  {
+    static const uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+        0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+        0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+        0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+        0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+    return k;
+  }
+
+  static const uint32_t *initialState()
+  {
+    static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                   0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                   0x1f83d9ab, 0x5be0cd19};
+    return iv;
+  }
+
+  static void sha256OpenSSL(const unsigned char *const *data,
+                            const size_t *lens, size_t count,
+                            unsigned char *out)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      SHA256_CTX ctx;
+      SHA256_Init(&ctx);
+      SHA256_Update(&ctx, data[i], lens[i]);
+      SHA256_Final(out + 32 * i, &ctx);
+    }
+  }
+
+#ifdef SHA256BATCH_X86
+  static bool cpuHasAvx2() { return __builtin_cpu_supports("avx2"); }
+
+  static bool cpuHasShaNi()
+  {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+      return false;
+    }
+    return (ebx >> 29) & 1;
+  }
+
+  // one message being hashed in one lane
+  struct Lane
+  {
+    const unsigned char *data;
+    size_t len;
+    size_t index;
+    size_t block;
+    size_t blocks;
+    unsigned char pad[64];
+  };
+
+  // the next 64 bytes of the lane's message, padded at the end
+  static const unsigned char *laneBlock(Lane &lane)
+  {
+    size_t off = lane.block * 64;
+    if (off + 64 <= lane.len)
+    {
+      return lane.data + off;
+    }
+    size_t rem = lane.len > off ? lane.len - off : 0;
+    if (rem > 0)
+    {
+      memcpy(lane.pad, lane.data + off, rem);
+    }
+    memset(lane.pad + rem, 0, 64 - rem);
+    if (lane.len >= off)
+    {
+      lane.pad[rem] = 0x80;
+    }
+    if (lane.block + 1 == lane.blocks)
+    {
+      uint64_t bits = (uint64_t)lane.len * 8;
+      for (int i = 0; i < 8; i++)
+      {
+        lane.pad[63 - i] = (unsigned char)(bits >> (8 * i));
+      }
+    }
+    return lane.pad;
+  }
+
+  __attribute__((target("avx2"))) static void
+  sha256Avx2(const unsigned char *const *data, const size_t *lens,
+             size_t count, unsigned char *out)
+  {
+    static const unsigned char zero_block[64] = {0};
+    const uint32_t *k = roundConstants();
+    const uint32_t *iv = initialState();
+    // state[word][lane]
+    uint32_t state[8][8];
+    Lane lanes[8];
+    bool active[8];
+    size_t next = 0;
+    int running = 0;
+    for (int l = 0; l < 8; l++)
+    {
+      active[l] = next < count;
+      if (active[l])
+      {
+        lanes[l].data = data[next];
+        lanes[l].len = lens[next];
+        lanes[l].index = next;
+        lanes[l].block = 0;
+        lanes[l].blocks = (lens[next] + 9 + 63) / 64;
+        next++;
+        running++;
+      }
+      for (int j = 0; j < 8; j++)
+      {
+        state[j][l] = iv[j];
+      }
+    }
+
+    const __m256i bswap = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6,
+        5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    while (running > 0)
+    {
+      const unsigned char *blocks[8];
+      for (int l = 0; l < 8; l++)
+      {
+        blocks[l] = active[l] ? laneBlock(lanes[l]) : zero_block;
+      }
+      // transpose 8 blocks of 16 words into 16 vectors of 8 lanes
+      __m256i w[16];
+      for (int h = 0; h < 2; h++)
+      {
+        __m256i r[8];
+        for (int l = 0; l < 8; l++)
+        {
+          r[l] = _mm256_loadu_si256((const __m256i *)(blocks[l] + 32 * h));
+        }
+        __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+        __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+        __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+        __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+        __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+        __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+        __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+        __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+        __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+        __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+        __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+        __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+        __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+        __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+        __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+        __m256i *dst = w + 8 * h;
+        dst[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+        dst[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+        dst[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+        dst[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+        dst[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+        dst[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+        dst[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+        dst[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+        for (int j = 0; j < 8; j++)
+        {
+          dst[j] = _mm256_shuffle_epi8(dst[j], bswap);
+        }
+      }
+
+#define SHA256BATCH_ROR(x, n) \
+  _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+      __m256i s[8];
+      for (int j = 0; j < 8; j++)
+      {
+        s[j] = _mm256_loadu_si256((const __m256i *)state[j]);
+      }
+      __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+      __m256i e = s[4], f = s[5], g = s[6], hh = s[7];
+      for (int t = 0; t < 64; t++)
+      {
+        __m256i wt;
+        if (t < 16)
+        {
+          wt = w[t];
+        }
+        else
+        {
+          __m256i w15 = w[(t - 15) & 15];
+          __m256i w2 = w[(t - 2) & 15];
+          __m256i s0 = _mm256_xor_si256(
+              _mm256_xor_si256(SHA256BATCH_ROR(w15, 7),
+                               SHA256BATCH_ROR(w15, 18)),
+              _mm256_srli_epi32(w15, 3));
+          __m256i s1 = _mm256_xor_si256(
+              _mm256_xor_si256(SHA256BATCH_ROR(w2, 17),
+                               SHA256BATCH_ROR(w2, 19)),
+              _mm256_srli_epi32(w2, 10));
+          wt = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                _mm256_add_epi32(w[(t - 7) & 15], s1));
+          w[t & 15] = wt;
+        }
+        __m256i sum1 = _mm256_xor_si256(
+            _mm256_xor_si256(SHA256BATCH_ROR(e, 6), SHA256BATCH_ROR(e, 11)),
+            SHA256BATCH_ROR(e, 25));
+        __m256i ch = _mm256_xor_si256(
+            g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+        __m256i t1 = _mm256_add_epi32(
+            _mm256_add_epi32(hh, sum1),
+            _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32(k[t])),
+                             wt));
+        __m256i sum0 = _mm256_xor_si256(
+            _mm256_xor_si256(SHA256BATCH_ROR(a, 2), SHA256BATCH_ROR(a, 13)),
+            SHA256BATCH_ROR(a, 22));
+        __m256i maj = _mm256_or_si256(
+            _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = _mm256_add_epi32(sum0, maj);
+        hh = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+      }
+#undef SHA256BATCH_ROR
+      __m256i fin[8] = {a, b, c, d, e, f, g, hh};
+      for (int j = 0; j < 8; j++)
+      {
+        _mm256_storeu_si256((__m256i *)state[j],
+                            _mm256_add_epi32(s[j], fin[j]));
+      }
+
+      for (int l = 0; l < 8; l++)
+      {
+        if (!active[l] || ++lanes[l].block < lanes[l].blocks)
+        {
+          continue;
+        }
+        unsigned char *digest = out + 32 * lanes[l].index;
+        for (int j = 0; j < 8; j++)
+        {
+          digest[4 * j] = (unsigned char)(state[j][l] >> 24);
+          digest[4 * j + 1] = (unsigned char)(state[j][l] >> 16);
+          digest[4 * j + 2] = (unsigned char)(state[j][l] >> 8);
+          digest[4 * j + 3] = (unsigned char)state[j][l];
+          state[j][l] = iv[j];
+        }
+        if (next < count)
+        {
+          lanes[l].data = data[next];
+          lanes[l].len = lens[next];
+          lanes[l].index = next;
+          lanes[l].block = 0;
+          lanes[l].blocks = (lens[next] + 9 + 63) / 64;
+          next++;
+        }
+        else
+        {
+          active[l] = false;
+          running--;
+        }
+      }
+    }
+  }
+#endif
+
+public:
+  static Sha256Impl resolve(Sha256Impl impl)
+  {
+#ifdef SHA256BATCH_X86
+    static const bool has_avx2 = cpuHasAvx2();
+    static const bool has_sha_ni = cpuHasShaNi();
+    if (impl == Sha256Impl::AUTO)
+    {
+      return has_avx2 && !has_sha_ni ? Sha256Impl::AVX2 : Sha256Impl::OPENSSL;
+    }
+    if (impl == Sha256Impl::AVX2 && !has_avx2)
+    {
+      return Sha256Impl::OPENSSL;
+    }
+    return impl;
+#else
+    return Sha256Impl::OPENSSL;
+#endif
+  }
+
+  // out receives count digests of 32 bytes, back to back
+  static void sha256(const unsigned char *const *data, const size_t *lens,
+                     size_t count, unsigned char *out,
+                     Sha256Impl impl = Sha256Impl::AUTO)
+  {
+#ifdef SHA256BATCH_X86
+    if (count > 1 && resolve(impl) == Sha256Impl::AVX2)
+    {
+      sha256Avx2(data, lens, count, out);
+      return;
+    }
+#endif
+    sha256OpenSSL(data, lens, count, out);
+  }
+
+  // sha256(sha256(m)) for every message, the second round is batched as well
+  static void hash256(const unsigned char *const *data, const size_t *lens,
+                      size_t count, unsigned char *out,
+                      Sha256Impl impl = Sha256Impl::AUTO)
+  {
+    std::vector<unsigned char> first(32 * count);
+    sha256(data, lens, count, first.data(), impl);
+    std::vector<const unsigned char *> digests(count);
+    std::vector<size_t> digest_lens(count, 32);
+    for (size_t i = 0; i < count; i++)
+    {
+      digests[i] = first.data() + 32 * i;
+    }
+    sha256(digests.data(), digest_lens.data(), count, out, impl);
+  }
+};
+
+#endif
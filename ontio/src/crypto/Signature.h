@@ -5,6 +5,8 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -14,10 +16,16 @@
 #include "../common/ErrorCode.hpp"
 #include "../sdk/exception/SDKException.h"
 #include "Curve.h"
+#include "ECKey.h"
 #include "SignatureScheme.h"
 
 class Signature
 {
+public:
+  // r || s of a P-256 signature, both zero padded to 32 bytes, or the
+  // 64 bytes of an Ed25519 signature
+  typedef std::array<unsigned char, 64> RawSignature;
+
 private:
   SignatureScheme scheme;
   std::vector<unsigned char> value;
@@ -83,41 +91,26 @@ public:
     return bytes;
   }
 
-  static std::string EC_get_pubkey_by_prikey(
-      const std::string &str_private_key, CurveName curve_name,
-      point_conversion_form_t from = POINT_CONVERSION_COMPRESSED)
+  // scheme byte || r || s, the same bytes toBytes() writes for a non SM2
+  // scheme without building a Signature first
+  static std::vector<unsigned char> toBytes(SignatureScheme scheme,
+                                            const RawSignature &raw)
   {
-    BIGNUM *prv = BN_new();
-    BN_hex2bn(&prv, str_private_key.c_str());
-    EC_KEY *ec_key;
-    ec_key =
-        EC_KEY_new_by_curve_name(CurveNameMethod::get_curve_nid(curve_name));
-    if (ec_key == NULL)
+    if (scheme == SignatureScheme::SM3withSM2)
     {
-      throw std::runtime_error("EC_KEY_new_by_curve_name() failed!");
+      throw std::runtime_error(ErrorCode::StrInvalidSignatureData);
     }
-    const EC_GROUP *group;
-    group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curve_name));
-    EC_KEY_set_private_key(ec_key, prv);
-
-    EC_POINT *pub;
-    pub = EC_POINT_new(group);
+    std::vector<unsigned char> bytes(raw.size() + 1);
+    bytes[0] = (unsigned char)SignatureSchemeMethod::ordinal(scheme);
+    std::copy(raw.begin(), raw.end(), bytes.begin() + 1);
+    return bytes;
+  }
 
-    BN_CTX *bn_ctx;
-    bn_ctx = BN_CTX_new();
-    if (EC_POINT_mul(group, pub, prv, NULL, NULL, bn_ctx) != 1)
-    {
-      throw std::runtime_error("EC_POINT_mul() failed!");
-    }
-    if (EC_KEY_set_public_key(ec_key, pub) != 1)
-    {
-      EC_KEY_free(ec_key);
-      throw std::runtime_error("EC_KEY_set_public_key() failed!");
-    }
-    std::string publicKey;
-    publicKey = EC_POINT_point2hex(group, pub, from, bn_ctx);
-    return publicKey;
+  static std::string EC_get_pubkey_by_prikey(
+      const std::string &str_private_key, CurveName curve_name,
+      point_conversion_form_t from = POINT_CONVERSION_COMPRESSED)
+  {
+    return ECKey(str_private_key, curve_name).getPublicKeyHex(from);
   }
 };
 
@@ -19,7 +19,11 @@
 #include <openssl/pem.h>
 
 #include "../common/ErrorCode.hpp"
+#include "../common/Helper.h"
+#include "CurveRegistry.h"
+#include "ECKey.h"
 #include "KeyType.hpp"
+#include "Signature.h"
 #include "SignatureScheme.h"
 
 #if defined(WIN32) || defined(_WIN64)
@@ -189,115 +193,115 @@ protected:
   }
 
   void EC_gen_pubkey_by_prikey(EC_KEY *ec_key) {
-    const EC_GROUP *group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    EC_POINT *pub;
-    pub = EC_POINT_new(group);
+    const EC_GROUP *group = CurveRegistry::group(curveName);
     const BIGNUM *pri = EC_KEY_get0_private_key(ec_key);
-
-    BN_CTX *bn_ctx;
-    bn_ctx = BN_CTX_new();
-    if (EC_POINT_mul(group, pub, pri, NULL, NULL, bn_ctx) != 1) {
-      throw std::runtime_error(ErrorCode::StrDataSignatureErr);
-    }
-    if (EC_KEY_set_public_key(ec_key, pub) != 1) {
-      EC_KEY_free(ec_key);
+    EC_POINT *pub = EC_POINT_new(group);
+    if (pub == NULL || EC_POINT_mul(group, pub, pri, NULL, NULL, NULL) != 1 ||
+        EC_KEY_set_public_key(ec_key, pub) != 1) {
+      EC_POINT_free(pub);
       throw std::runtime_error(ErrorCode::StrDataSignatureErr);
     }
     EC_POINT_free(pub);
-    BN_free((BIGNUM *)pri);
   }
 
   bool EC_set_public_key(const std::string &str_public_key, EC_KEY *ec_key) {
     if (ec_key == NULL) {
       throw std::runtime_error("EC_KEY is NULL");
     }
-
-    EC_GROUP *group;
-    group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    if (group == NULL) {
-      throw std::runtime_error("EC_GROUP_new_by_curve_name() failed.");
-    }
-
-    EC_POINT *pub;
-    pub = EC_POINT_new(group);
-    pub = EC_POINT_hex2point(group, str_public_key.c_str(), NULL, NULL);
-
-    if (EC_KEY_set_public_key(ec_key, pub) != 1) {
-      EC_GROUP_free(group);
-      return false;
-    }
-    return true;
+    EC_POINT *pub = EC_POINT_hex2point(CurveRegistry::group(curveName),
+                                       str_public_key.c_str(), NULL, NULL);
+    bool ok = pub != NULL && EC_KEY_set_public_key(ec_key, pub) == 1;
+    EC_POINT_free(pub);
+    return ok;
   }
 
   bool EC_set_private_key(const std::string &str_private_key, EC_KEY *ec_key) {
-    EC_GROUP *group;
-    group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    if (group == NULL) {
-      return false;
-    }
-
-    ec_key =
-        EC_KEY_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
     if (ec_key == NULL) {
-      EC_GROUP_free(group);
+      throw std::runtime_error("EC_KEY is NULL");
+    }
+    if (EC_KEY_get0_group(ec_key) == NULL &&
+        EC_KEY_set_group(ec_key, CurveRegistry::group(curveName)) != 1) {
       return false;
     }
-    BIGNUM *prv = BN_new();
-    BN_hex2bn(&prv, str_private_key.c_str());
-    if (EC_KEY_set_private_key(ec_key, prv) != 1) {
-      EC_KEY_free(ec_key);
-      EC_GROUP_free(group);
+    BIGNUM *prv = NULL;
+    if (BN_hex2bn(&prv, str_private_key.c_str()) == 0) {
       return false;
     }
-    return true;
+    bool ok = EC_KEY_set_private_key(ec_key, prv) == 1;
+    BN_clear_free(prv);
+    return ok;
   }
 
   std::vector<unsigned char>
   DSADERtoPlain(const unsigned char *cst_uc_sign_dgst, int slen) {
-    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_new();
-    d2i_ECDSA_SIG(&ecdsa_sig, &cst_uc_sign_dgst, slen);
-    const BIGNUM *pr = BN_new();
-    const BIGNUM *ps = BN_new();
-    ECDSA_SIG_get0(ecdsa_sig, &pr, &ps);
-    std::vector<unsigned char> r_vec;
-    std::vector<unsigned char> s_vec;
-    r_vec = Helper::hexStringToByte(BN_bn2hex(pr));
-    s_vec = Helper::hexStringToByte(BN_bn2hex(ps));
+    ECDSA_SIG *ecdsa_sig = d2i_ECDSA_SIG(NULL, &cst_uc_sign_dgst, slen);
+    if (ecdsa_sig == NULL) {
+      throw std::runtime_error("d2i_ECDSA_SIG() failed.");
+    }
+    std::vector<unsigned char> res(2 * ECDSA_half_size(curveName));
+    bool ok = ECDSA_SIG_to_plain(ecdsa_sig, res.data(), res.size() / 2);
     ECDSA_SIG_free(ecdsa_sig);
-    std::vector<unsigned char> res;
-    res.insert(res.end(), r_vec.begin(), r_vec.end());
-    res.insert(res.end(), s_vec.begin(), s_vec.end());
+    if (!ok) {
+      throw std::runtime_error("BN_bn2binpad() failed.");
+    }
     return res;
   }
 
   std::vector<unsigned char>
   DSAPlaintoDER(const std::vector<unsigned char> &sig) {
-    BIGNUM *r = BN_new();
-    BIGNUM *s = BN_new();
-    std::vector<unsigned char> r_vec;
-    r_vec.insert(r_vec.end(), sig.begin(), sig.begin() + sig.size() / 2);
-    std::string r_str = Helper::toHexString(r_vec);
-    r_str.assign(r_str, 2, r_str.size() - 2);
-    BN_hex2bn(&r, r_str.c_str());
-    std::vector<unsigned char> s_vec;
-    s_vec.insert(s_vec.end(), sig.begin() + sig.size() / 2, sig.end());
-    std::string s_str = Helper::toHexString(s_vec);
-    s_str.assign(s_str, 2, s_str.size() - 2);
-    BN_hex2bn(&s, s_str.c_str());
-    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_new();
-    if (!ECDSA_SIG_set0(ecdsa_sig, r, s)) {
+    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_from_plain(sig.data(), sig.size());
+    if (ecdsa_sig == NULL) {
       throw runtime_error("ECDSA_SIG_set0() failure");
     }
-    unsigned char *der = new unsigned char[sig.size() * 2];
+    unsigned char *der = NULL;
     int len = i2d_ECDSA_SIG(ecdsa_sig, &der);
     ECDSA_SIG_free(ecdsa_sig);
+    if (len <= 0) {
+      throw runtime_error("i2d_ECDSA_SIG() failure");
+    }
     std::vector<unsigned char> der_vec(der, der + len);
+    OPENSSL_free(der);
     return der_vec;
   }
 
+  // bytes of r and of s in a plain signature, the size of the group order
+  static size_t ECDSA_half_size(CurveName curve_name) {
+    if (curve_name == CurveName::p256) {
+      return 32;
+    }
+    return (EC_GROUP_order_bits(CurveRegistry::group(curve_name)) + 7) / 8;
+  }
+
+  // writes r and s big endian, each zero padded to half bytes
+  static bool ECDSA_SIG_to_plain(const ECDSA_SIG *ecdsa_sig,
+                                 unsigned char *out, size_t half) {
+    const BIGNUM *pr = NULL;
+    const BIGNUM *ps = NULL;
+    ECDSA_SIG_get0(ecdsa_sig, &pr, &ps);
+    return BN_bn2binpad(pr, out, (int)half) == (int)half &&
+           BN_bn2binpad(ps, out + half, (int)half) == (int)half;
+  }
+
+  // NULL unless len splits into two equal halves
+  static ECDSA_SIG *ECDSA_SIG_from_plain(const unsigned char *sig,
+                                         size_t len) {
+    if (len == 0 || len % 2 != 0) {
+      return NULL;
+    }
+    size_t half = len / 2;
+    BIGNUM *r = BN_bin2bn(sig, (int)half, NULL);
+    BIGNUM *s = BN_bin2bn(sig + half, (int)half, NULL);
+    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_new();
+    if (r == NULL || s == NULL || ecdsa_sig == NULL ||
+        ECDSA_SIG_set0(ecdsa_sig, r, s) != 1) {
+      BN_free(r);
+      BN_free(s);
+      ECDSA_SIG_free(ecdsa_sig);
+      return NULL;
+    }
+    return ecdsa_sig;
+  }
+
 public:
   SignatureHandler(KeyType _type, SignatureScheme _scheme, CurveName _curve)
       : keyType(_type), signScheme(_scheme), curveName(_curve) {
@@ -309,118 +313,164 @@ public:
 
   ~SignatureHandler() { EVP_MD_CTX_free(md_ctx); }
 
-  std::vector<unsigned char>
-  generateSignature(const std::string &privateKey,
-                    const std::vector<unsigned char> &msg,
-                    const std::string &sm2_param) {
-    BIGNUM *prv = BN_new();
-    BN_hex2bn(&prv, privateKey.c_str());
-    EC_KEY *ec_key =
-        EC_KEY_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    if (ec_key == NULL) {
+  // ECDSA over an already hashed message with a parsed P-256 key, r || s
+  // without any intermediate allocation
+  static Signature::RawSignature ECDSA_sign_raw(const ECKey &key,
+                                                const unsigned char *msg,
+                                                size_t len) {
+    if (key.get() == NULL) {
       throw std::runtime_error("EC_KEY is NULL.");
     }
-    EC_KEY_set_private_key(ec_key, prv);
-
-    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_new();
-    ecdsa_sig = ECDSA_do_sign(msg.data(), msg.size(), ec_key);
-    const BIGNUM *pr = BN_new();
-    const BIGNUM *ps = BN_new();
-    ECDSA_SIG_get0(ecdsa_sig, &pr, &ps);
+    ECDSA_SIG *ecdsa_sig = ECDSA_do_sign(msg, (int)len, key.get());
+    if (ecdsa_sig == NULL) {
+      throw std::runtime_error("ECDSA_do_sign() failed.");
+    }
+    Signature::RawSignature raw;
+    bool ok = ECDSA_SIG_to_plain(ecdsa_sig, raw.data(), raw.size() / 2);
+    ECDSA_SIG_free(ecdsa_sig);
+    if (!ok) {
+      throw std::runtime_error("ECDSA_sign_raw() needs a P-256 key.");
+    }
+    return raw;
+  }
 
-    std::vector<unsigned char> r_vec;
-    std::vector<unsigned char> s_vec;
-    r_vec = Helper::hexStringToByte(BN_bn2hex(pr));
-    s_vec = Helper::hexStringToByte(BN_bn2hex(ps));
-    std::vector<unsigned char> vec;
-    vec.insert(vec.end(), r_vec.begin(), r_vec.end());
-    vec.insert(vec.end(), s_vec.begin(), s_vec.end());
+  // the same for any curve, r || s padded to ECDSA_half_size(curve_name)
+  static std::vector<unsigned char>
+  ECDSA_sign_digest(const ECKey &key, const std::vector<unsigned char> &msg,
+                    CurveName curve_name = CurveName::p256) {
+    if (key.get() == NULL) {
+      throw std::runtime_error("EC_KEY is NULL.");
+    }
+    ECDSA_SIG *ecdsa_sig = ECDSA_do_sign(msg.data(), (int)msg.size(), key.get());
+    if (ecdsa_sig == NULL) {
+      throw std::runtime_error("ECDSA_do_sign() failed.");
+    }
+    std::vector<unsigned char> vec(2 * ECDSA_half_size(curve_name));
+    bool ok = ECDSA_SIG_to_plain(ecdsa_sig, vec.data(), vec.size() / 2);
+    ECDSA_SIG_free(ecdsa_sig);
+    if (!ok) {
+      throw std::runtime_error("BN_bn2binpad() failed.");
+    }
     return vec;
   }
 
+  // Ed25519 hashes msg itself with SHA-512, R || S
+  static Signature::RawSignature EDDSA_sign_raw(const ECKey &key,
+                                                const unsigned char *msg,
+                                                size_t len) {
+    if (!key.isEd25519()) {
+      throw std::runtime_error("EDDSA_sign_raw() needs an Ed25519 key.");
+    }
+    std::unique_ptr<EVP_MD_CTX, void (*)(EVP_MD_CTX *)> ctx(EVP_MD_CTX_new(),
+                                                            EVP_MD_CTX_free);
+    Signature::RawSignature raw;
+    size_t slen = raw.size();
+    if (!ctx ||
+        EVP_DigestSignInit(ctx.get(), NULL, NULL, NULL, key.getEvpPkey()) !=
+            1 ||
+        EVP_DigestSign(ctx.get(), raw.data(), &slen, msg, len) != 1 ||
+        slen != raw.size()) {
+      throw std::runtime_error("EVP_DigestSign() failed.");
+    }
+    return raw;
+  }
+
+  static bool EDDSA_verify(const ECKey &key, const unsigned char *msg,
+                           size_t len, const std::vector<unsigned char> &sig) {
+    if (!key.isEd25519() || sig.size() != 64) {
+      return false;
+    }
+    std::unique_ptr<EVP_MD_CTX, void (*)(EVP_MD_CTX *)> ctx(EVP_MD_CTX_new(),
+                                                            EVP_MD_CTX_free);
+    if (!ctx || EVP_DigestVerifyInit(ctx.get(), NULL, NULL, NULL,
+                                     key.getEvpPkey()) != 1) {
+      throw std::runtime_error("EVP_DigestVerifyInit() failed.");
+    }
+    return EVP_DigestVerify(ctx.get(), sig.data(), sig.size(), msg, len) == 1;
+  }
+
+  std::vector<unsigned char>
+  generateSignature(const ECKey &key, const std::vector<unsigned char> &msg,
+                    const std::string &sm2_param) {
+    if (keyType == KeyType::EDDSA) {
+      return generateSignature(key, msg, sm2_param, false);
+    }
+    return ECDSA_sign_digest(key, msg, curveName);
+  }
+
   std::vector<unsigned char>
   generateSignature(const std::string &privateKey,
-                    const std::vector<unsigned char> &msg, CurveName curve_name,
+                    const std::vector<unsigned char> &msg,
                     const std::string &sm2_param) {
-    BIGNUM *prv = BN_new();
-    BN_hex2bn(&prv, privateKey.c_str());
+    return generateSignature(ECKey(privateKey, curveName), msg, sm2_param);
+  }
 
-    EC_KEY *ec_key;
-    ec_key =
-        EC_KEY_new_by_curve_name(CurveNameMethod::get_curve_nid(curve_name));
-    if (ec_key == NULL) {
-      throw std::runtime_error("EC_KEY is NULL.");
+  std::vector<unsigned char>
+  generateSignature(const ECKey &key, const std::vector<unsigned char> &msg,
+                    const std::string &sm2_param, bool hash_msg) {
+    if (keyType == KeyType::EDDSA) {
+      Signature::RawSignature raw = EDDSA_sign_raw(key, msg.data(), msg.size());
+      return std::vector<unsigned char>(raw.begin(), raw.end());
     }
-
-    EC_KEY_set_private_key(ec_key, prv);
-    try {
-      md_ctx_sign_init();
-    } catch (const std::runtime_error &err) {
-      std::cerr << err.what() << std::endl;
+    if (!hash_msg) {
+      return ECDSA_sign_digest(key, msg, curveName);
     }
+    md_ctx_sign_init();
     if (EVP_SignUpdate(md_ctx, msg.data(), msg.size()) != 1) {
       throw std::runtime_error("EVP_SignUpdate() != 1");
     }
-
-    EVP_PKEY *evp_pkey = EVP_PKEY_new();
-    EVP_PKEY_assign_EC_KEY(evp_pkey, ec_key);
-
     unsigned int slen = 0;
     std::unique_ptr<unsigned char[]> uc_sign_dgst(
-        new unsigned char[EVP_PKEY_size(evp_pkey)]);
-    if (EVP_SignFinal(md_ctx, uc_sign_dgst.get(), &slen, evp_pkey) != 1) {
+        new unsigned char[EVP_PKEY_size(key.getEvpPkey())]);
+    if (EVP_SignFinal(md_ctx, uc_sign_dgst.get(), &slen, key.getEvpPkey()) !=
+        1) {
       throw std::runtime_error("EVP_SignFinal() != 1");
     }
-    std::vector<unsigned char> vec_sign_dgst;
-    vec_sign_dgst = DSADERtoPlain(uc_sign_dgst.get(), slen);
-    return vec_sign_dgst;
+    return DSADERtoPlain(uc_sign_dgst.get(), slen);
   }
 
-  bool verifySignature(const std::string &publicKey,
-                       const std::vector<unsigned char> &msg,
-                       const std::vector<unsigned char> &sign_dgst_vec) {
-    EC_GROUP *group;
-    group =
-        EC_GROUP_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    if (group == NULL) {
-      throw std::runtime_error("EC_GROUP_new_by_curve_name() failed.");
-    }
-    EC_POINT *pub;
-    pub = EC_POINT_new(group);
-    pub = EC_POINT_hex2point(group, publicKey.c_str(), NULL, NULL);
+  std::vector<unsigned char>
+  generateSignature(const std::string &privateKey,
+                    const std::vector<unsigned char> &msg, CurveName curve_name,
+                    const std::string &sm2_param) {
+    return generateSignature(ECKey(privateKey, curve_name), msg, sm2_param,
+                             true);
+  }
 
-    EC_KEY *ec_key;
-    ec_key =
-        EC_KEY_new_by_curve_name(CurveNameMethod::get_curve_nid(curveName));
-    if (ec_key == NULL) {
-      throw std::runtime_error("EC_KEY is NULL.");
+  // r || s split in halves, as produced by ECDSA_sign_digest
+  static bool ECDSA_verify_digest(const ECKey &key,
+                                  const std::vector<unsigned char> &msg,
+                                  const std::vector<unsigned char> &sig) {
+    if (key.get() == NULL) {
+      return false;
     }
-    EC_KEY_set_public_key(ec_key, pub);
-
-    BIGNUM *r = BN_new();
-    BIGNUM *s = BN_new();
-
-    std::vector<unsigned char> r_vec;
-    r_vec.insert(r_vec.end(), sign_dgst_vec.begin(),
-                 sign_dgst_vec.begin() + sign_dgst_vec.size() / 2);
-    std::string r_str = Helper::toHexString(r_vec);
-    r_str.assign(r_str, 2, r_str.size() - 2);
-    BN_hex2bn(&r, r_str.c_str());
-
-    std::vector<unsigned char> s_vec;
-    s_vec.insert(s_vec.end(), sign_dgst_vec.begin() + sign_dgst_vec.size() / 2,
-                 sign_dgst_vec.end());
-    std::string s_str = Helper::toHexString(s_vec);
-    s_str.assign(s_str, 2, s_str.size() - 2);
-    BN_hex2bn(&s, s_str.c_str());
+    ECDSA_SIG *ecdsa_sig = ECDSA_SIG_from_plain(sig.data(), sig.size());
+    if (ecdsa_sig == NULL) {
+      return false;
+    }
+    int ret =
+        ECDSA_do_verify(msg.data(), (int)msg.size(), ecdsa_sig, key.get());
+    ECDSA_SIG_free(ecdsa_sig);
+    return ret == 1;
+  }
 
-    ECDSA_SIG *ecdsa_sig2 = ECDSA_SIG_new();
-    ECDSA_SIG_set0(ecdsa_sig2, r, s);
-    int ret = ECDSA_do_verify(msg.data(), msg.size(), ecdsa_sig2, ec_key);
-    if (ret != 1) {
+  bool verifySignature(const std::string &publicKey,
+                       const std::vector<unsigned char> &msg,
+                       const std::vector<unsigned char> &sign_dgst_vec) {
+    ECKey key;
+    try {
+      if (keyType == KeyType::EDDSA) {
+        // the serialized form starts with the key type and curve labels
+        std::string raw_key = publicKey.size() == 68 ? publicKey.substr(4)
+                                                     : publicKey;
+        key = ECKey::fromPublicKeyHex(raw_key, CurveName::ED25519);
+        return EDDSA_verify(key, msg.data(), msg.size(), sign_dgst_vec);
+      }
+      key = ECKey::fromPublicKeyHex(publicKey, curveName);
+    } catch (const std::runtime_error &) {
       return false;
     }
-    return true;
+    return ECDSA_verify_digest(key, msg, sign_dgst_vec);
   }
 };
 
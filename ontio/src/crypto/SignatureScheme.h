@@ -17,7 +17,8 @@ enum class SignatureScheme : int {
   SHA3_384withECDSA,
   SHA3_512withECDSA,
   RIPEMD160withECDSA,
-  SM3withSM2
+  SM3withSM2,
+  SHA512withEDDSA
 };
 
 class SignatureSchemeMethod {
@@ -55,6 +56,9 @@ public:
     case SignatureScheme::SM3withSM2:
       ret = 9;
       break;
+    case SignatureScheme::SHA512withEDDSA:
+      ret = 10;
+      break;
     default:
       throw std::runtime_error("SignatureScheme Error!");
       break;
@@ -95,6 +99,9 @@ public:
     case SignatureScheme::SM3withSM2:
       name = "SM3withSM2";
       break;
+    case SignatureScheme::SHA512withEDDSA:
+      name = "SHA512withEdDSA";
+      break;
     default:
       throw "SignatureScheme Error!";
       break;
@@ -124,6 +131,8 @@ public:
       scheme = SignatureScheme::RIPEMD160withECDSA;
     } else if (name == "SM3withSM2") {
       scheme = SignatureScheme::SM3withSM2;
+    } else if (name == "SHA512withEdDSA") {
+      scheme = SignatureScheme::SHA512withEDDSA;
     } else {
       throw "SignatureScheme Error!";
     }
@@ -163,6 +172,9 @@ public:
     case 0x09:
       scheme = SignatureScheme::SM3withSM2;
       break;
+    case 0x0a:
+      scheme = SignatureScheme::SHA512withEDDSA;
+      break;
     default:
       throw runtime_error(
           "toSignatureScheme() Error: Unsupport SignatureScheme");
@@ -5,230 +5,188 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
-#include <boost/algorithm/hex.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
-
 #include "../common/ErrorCode.hpp"
+#include "../common/Helper.h"
 
 using namespace std;
 
+// BinaryReader decodes the Ontology wire format from a non-owning view of raw
+// bytes. Integers are little-endian, varints use the 0xFD/0xFE/0xFF prefixes.
+// set_uc_vec() keeps the old hex-text input working by decoding the text once
+// into an owned buffer and pointing the view at it.
 class BinaryReader
 {
 private:
+  // only used by the hex adapter, the binary view never copies its input
   std::vector<unsigned char> uc_vec;
-  std::vector<unsigned char>::iterator uc_vec_iter;
+  const unsigned char *uc_begin;
+  const unsigned char *uc_pos;
+  const unsigned char *uc_end;
 
-  // LittleEndian
-  long long bytes2ToLong(unsigned char *bytes)
+  const unsigned char *take(size_t count)
   {
-    long long addr = bytes[0] & 0xFF;
-    addr |= (((long long)bytes[1] << 8) & 0xFF00);
-    return addr;
+    if ((size_t)(uc_end - uc_pos) < count)
+    {
+      throw std::runtime_error("IOException");
+    }
+    const unsigned char *p = uc_pos;
+    uc_pos += count;
+    return p;
   }
 
   // LittleEndian
-  long long bytes8ToLong(unsigned char *bytes)
+  static uint16_t bytes2ToUInt(const unsigned char *bytes)
   {
-    long long addr = bytes[0] & 0xFF;
-    addr |= (((long long)bytes[1] << 8) & 0xFF00);
-    addr |= (((long long)bytes[2] << 16) & 0xFF0000);
-    addr |= (((long long)bytes[3] << 24) & 0xFF000000);
-    addr |= (((long long)bytes[4] << 32) & 0xFF00000000);
-    addr |= (((long long)bytes[5] << 40) & 0xFF0000000000);
-    addr |= (((long long)bytes[6] << 48) & 0xFF000000000000);
-    addr |= (((long long)bytes[7] << 56) & 0xFF00000000000000);
-    return addr;
+    return (uint16_t)(bytes[0] | ((uint16_t)bytes[1] << 8));
   }
 
   // LittleEndian
-  long long bytesNToLong(unsigned char *bytes, int buf_size)
+  static uint32_t bytes4ToUInt(const unsigned char *bytes)
   {
-    int pos = 8;
-    long long base = 0xFF;
-    long long val = bytes[0] & base;
-    for (int i = 0; i < buf_size; i++)
-    {
-      val |= (((long long)bytes[i] << (pos * i)) & (base << (2 * i)));
-    }
-    return val;
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+           ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
   }
 
-  long long ReadBytesToLong(int len)
+  // LittleEndian
+  static uint64_t bytes8ToUInt(const unsigned char *bytes)
   {
-    char buf[len];
-    if (sizeof(long long) != 8)
-    {
-      std::runtime_error("IOException");
-    }
-    uc_vec_iter++;
-    for (int i = 0; i < len; i += 2)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      buf[len - 2 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      buf[len - 1 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-    }
-    long long ret;
-    std::stringstream ss;
-    ss.str(buf);
-    ss >> std::hex >> ret;
-    return ret;
+    return (uint64_t)bytes4ToUInt(bytes) |
+           ((uint64_t)bytes4ToUInt(bytes + 4) << 32);
   }
 
 public:
-  void set_uc_vec(std::string &str)
+  BinaryReader() : uc_begin(nullptr), uc_pos(nullptr), uc_end(nullptr) {}
+
+  BinaryReader(const unsigned char *data, size_t size)
+      : uc_begin(data), uc_pos(data), uc_end(data + size) {}
+
+  BinaryReader(const std::vector<unsigned char> &data)
+      : uc_begin(data.data()), uc_pos(data.data()),
+        uc_end(data.data() + data.size()) {}
+
+  // the view must not outlive the bytes it points to
+  BinaryReader(const BinaryReader &) = delete;
+  BinaryReader &operator=(const BinaryReader &) = delete;
+
+  void set_uc_span(const unsigned char *data, size_t size)
   {
-    // std::string hex_str = boost::algorithm::hex(str);
     uc_vec.clear();
-    for (int i = 0; i < int(str.length()); i++)
-    {
-      uc_vec.push_back((unsigned char)str[i]);
-    }
-    uc_vec_iter = uc_vec.begin();
+    uc_begin = data;
+    uc_pos = data;
+    uc_end = data + size;
   }
 
-  std::vector<unsigned char> toByteArray() { return uc_vec; }
-
-  void read(std::vector<unsigned char> &buffer)
+  // hex text input, e.g. a raw transaction returned by the node
+  void set_uc_vec(const std::string &str)
   {
-    // TODO
-    buffer.insert(buffer.begin(), uc_vec_iter, uc_vec_iter + buffer.size());
-    uc_vec_iter += buffer.size();
+    uc_vec = Helper::hexStringToByte(str);
+    uc_begin = uc_vec.data();
+    uc_pos = uc_begin;
+    uc_end = uc_begin + uc_vec.size();
   }
 
-  long long readVarInt(long long max)
+  size_t position() const { return (size_t)(uc_pos - uc_begin); }
+
+  size_t available() const { return (size_t)(uc_end - uc_pos); }
+
+  std::vector<unsigned char> toByteArray()
   {
-    int tag;
-    int tag_size = 2;
-    char tag_buf[tag_size];
-    tag_buf[0] = *uc_vec_iter;
-    uc_vec_iter++;
-    if (uc_vec_iter == uc_vec.end())
-    {
-      std::runtime_error("IOException");
-    }
-    tag_buf[1] = *uc_vec_iter;
-    uc_vec_iter++;
-    std::stringstream ss;
-    ss.str(tag_buf);
-    ss >> std::hex >> tag;
+    return std::vector<unsigned char>(uc_begin, uc_end);
+  }
 
-    long long value;
-    if (tag == 0xFD)
-    {
-      int buf_size = 2;
-      value = ReadBytesToLong(buf_size);
-    }
-    else if (tag == 0xFE)
-    {
-      int buf_size = 4;
-      value = ReadBytesToLong(buf_size);
-    }
-    else if (tag == 0xFF)
+  // moves the decoded hex buffer out instead of copying it, a plain view still
+  // has to copy since it does not own the bytes
+  std::vector<unsigned char> take() &&
+  {
+    std::vector<unsigned char> ret;
+    if (!uc_vec.empty() && uc_begin == uc_vec.data())
     {
-      int buf_size = 8;
-      value = ReadBytesToLong(buf_size);
+      ret = std::move(uc_vec);
     }
     else
     {
-      value = tag;
-    }
-    if (value > max)
-    {
-      throw "readVarInt Error! value > max!";
+      ret.assign(uc_begin, uc_end);
     }
-    return value;
+    set_uc_span(nullptr, 0);
+    return ret;
   }
 
-  long long readVarInt()
+  void read(std::vector<unsigned char> &buffer)
   {
-    int tag;
-    int tag_size = 2;
-    char tag_buf[tag_size];
-    tag_buf[0] = *uc_vec_iter;
-    uc_vec_iter++;
-    if (uc_vec_iter == uc_vec.end())
+    if (buffer.empty())
     {
-      std::runtime_error("IOException");
+      return;
     }
-    tag_buf[1] = *uc_vec_iter;
-    uc_vec_iter++;
-    std::stringstream ss;
-    ss.str(tag_buf);
-    ss >> std::hex >> tag;
-    long long value;
+    memcpy(buffer.data(), take(buffer.size()), buffer.size());
+  }
+
+  void read(unsigned char *buffer, size_t count)
+  {
+    memcpy(buffer, take(count), count);
+  }
+
+  // zero-copy access to the next count bytes, valid as long as the input is
+  const unsigned char *readSpan(size_t count) { return take(count); }
+
+  uint8_t readUInt8() { return *take(1); }
+
+  uint16_t readUInt16() { return bytes2ToUInt(take(2)); }
+
+  uint32_t readUInt32() { return bytes4ToUInt(take(4)); }
+
+  uint64_t readUInt64() { return bytes8ToUInt(take(8)); }
+
+  uint64_t readVarUInt()
+  {
+    unsigned char tag = readUInt8();
     if (tag == 0xFD)
     {
-      int buf_size = 2;
-      value = ReadBytesToLong(buf_size);
+      return readUInt16();
     }
     else if (tag == 0xFE)
     {
-      int buf_size = 4;
-      value = ReadBytesToLong(buf_size);
+      return readUInt32();
     }
     else if (tag == 0xFF)
     {
-      int buf_size = 8;
-      value = ReadBytesToLong(buf_size);
+      return readUInt64();
     }
-    else
+    return tag;
+  }
+
+  long long readVarInt(long long max)
+  {
+    long long value = (long long)readVarUInt();
+    if (value < 0 || value > max)
     {
-      value = tag;
+      throw "readVarInt Error! value > max!";
     }
     return value;
   }
 
-  int readByte()
-  {
-    int ret;
-    std::stringstream ss;
-    ss.str(readBytes(1));
-    ss >> std::hex >> ret;
-    return ret;
-  }
+  long long readVarInt() { return (long long)readVarUInt(); }
+
+  int readByte() { return readUInt8(); }
 
   std::string readBytes(int count)
   {
-    std::string str;
-    for (int i = 0; i < 2 * count; i++)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      str.push_back(*uc_vec_iter);
-      uc_vec_iter++;
-    }
-    return str;
+    return Helper::toHexString((unsigned char *)take(count), count);
   }
 
   std::vector<unsigned char> readBytes_vec(int count)
   {
-    std::vector<unsigned char> ret_vec;
-    for (int i = 0; i < 2 * count; i++)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      ret_vec.push_back(*uc_vec_iter);
-      uc_vec_iter++;
-    }
-    return ret_vec;
+    const unsigned char *p = take(count);
+    return std::vector<unsigned char>(p, p + count);
   }
 
   std::string readVarBytes() { return readVarBytes(0X7fffffc7); }
@@ -252,130 +210,27 @@ public:
 
   float readFloat()
   {
-    int array[8];
-    for (int i = 0; i < 4; i++)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      uc_vec_iter++;
-      array[i] = *uc_vec_iter;
-    }
-    if (sizeof(float) != 4)
-    {
-      throw std::runtime_error("IOException");
-    }
-    float *ret = (float *)array;
-    return *ret;
+    uint32_t bits = readUInt32();
+    float ret;
+    memcpy(&ret, &bits, sizeof(ret));
+    return ret;
   }
 
-  unsigned char readBool()
-  {
-    if (sizeof(bool) != 1)
-    {
-      throw std::runtime_error("IOException");
-    }
-
-    unsigned char uc = *uc_vec_iter;
-    bool ret_bool = uc != 0;
-    return ret_bool;
-  }
+  unsigned char readBool() { return readUInt8() != 0; }
 
-  unsigned int readInt()
-  {
-    char buf[8];
-    if (sizeof(int) != 4)
-    {
-      std::runtime_error("IOException");
-    }
-    for (int i = 0; i < 8; i += 2)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-
-      buf[6 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      buf[7 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-    }
-    unsigned int ret;
-    std::stringstream ss;
-    ss.str(buf);
-    ss >> hex >> ret;
-    return ret;
-  }
+  unsigned int readInt() { return readUInt32(); }
 
-  long long readLong()
-  {
-    char buf[16];
-    if (sizeof(long long) != 8)
-    {
-      std::runtime_error("IOException");
-    }
-    for (int i = 0; i < 16; i += 2)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      buf[14 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      buf[15 - i] = *uc_vec_iter;
-      uc_vec_iter++;
-    }
-    long long ret;
-    std::stringstream ss;
-    ss.str(buf);
-    ss >> hex >> ret;
-    return ret;
-  }
+  long long readLong() { return (long long)readUInt64(); }
 
-  std::string Read8Bytes()
-  {
-    std::string str;
-    for (int i = 0; i < 64; i++)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      str.push_back(*uc_vec_iter);
-      uc_vec_iter++;
-    }
-    return str;
-  }
+  std::string Read8Bytes() { return readBytes(32); }
 
-  std::string Read5Bytes()
-  {
-    std::string str;
-    for (int i = 0; i < 40; i++)
-    {
-      if (uc_vec_iter == uc_vec.end())
-      {
-        std::runtime_error("IOException");
-      }
-      str.push_back(*uc_vec_iter);
-      uc_vec_iter++;
-    }
-    return str;
-  }
+  std::string Read5Bytes() { return readBytes(20); }
 
   std::string readVarString()
   {
-    std::string bytes;
-    bytes = readVarBytes();
-    return bytes;
+    int len = (int)readVarInt(0X7fffffc7);
+    const unsigned char *p = take(len);
+    return std::string((const char *)p, len);
   }
 
   template <class T>
@@ -388,6 +243,8 @@ public:
   void readSerializableArray(std::vector<T> &t_vec)
   {
     int vec_len = (int)readVarInt(0x10000000);
+    // every item takes at least one byte, don't trust the length prefix
+    t_vec.reserve(t_vec.size() + std::min((size_t)vec_len, available()));
     for (int i = 0; i < vec_len; i++)
     {
       T t_item;
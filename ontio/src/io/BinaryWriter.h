@@ -5,264 +5,174 @@
 #error "use --std=c++11 option for compile."
 #endif
 
-#include <codecvt>
-#include <fstream>
-#include <iostream>
-#include <math.h>
+#include <stdexcept>
 #include <string.h>
 #include <string>
+#include <utility>
 #include <vector>
 
-// std::string myhexStr(unsigned char *data, int len)
-// {
-//   char hexmap[] = {'0', '1', '2', '3', '4', '5', '6', '7',
-//                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-//   std::string s(len * 2, ' ');
-//   for (int i = 0; i < len; ++i)
-//   {
-//     s[2 * i] = hexmap[(data[i] & 0xF0) >> 4];
-//     s[2 * i + 1] = hexmap[data[i] & 0x0F];
-//   }
-//   return s;
-// }
-
 class BinaryWriter
 {
 private:
   std::vector<unsigned char> uc_vec;
 
-  void bytes_push_back(unsigned char *bytes, int len)
+  // LittleEndian, straight into the buffer
+  void writeLE(unsigned long long v, int bytes_len)
   {
-    for (int i = 0; i < len; i++)
+    unsigned char bytes[8];
+    for (int i = 0; i < bytes_len; i++)
     {
-      uc_vec.push_back(bytes[i]);
+      bytes[i] = (v >> (8 * i)) & 0xFF;
     }
+    uc_vec.insert(uc_vec.end(), bytes, bytes + bytes_len);
   }
 
-  void long2bytes(const long long v, unsigned char *bytes, int bytes_len)
+public:
+  BinaryWriter() {}
+
+  // capacity is usually Serializable::serializedSize(), so that serializing
+  // never has to grow the buffer
+  explicit BinaryWriter(size_t capacity) { uc_vec.reserve(capacity); }
+
+  void reserve(size_t capacity) { uc_vec.reserve(capacity); }
+
+  size_t size() const { return uc_vec.size(); }
+
+  size_t capacity() const { return uc_vec.capacity(); }
+
+  std::vector<unsigned char> toByteArray() { return uc_vec; }
+
+  // moves the buffer out, the writer is left empty
+  std::vector<unsigned char> take() && { return std::move(uc_vec); }
+
+  const std::vector<unsigned char> &bytes() const { return uc_vec; }
+
+  // drops the content but keeps the capacity, so one writer can be reused for
+  // many serializations without touching the heap again
+  void reset() { uc_vec.clear(); }
+
+  static size_t varIntSize(long long v)
   {
-    for (int i = 1; i < bytes_len; i++)
+    if (v < 0xFD)
     {
-      bytes[i] = (v >> 8 * (8 - i)) & 0xFF;
+      return 1;
     }
-  }
-
-  std::vector<unsigned char> long2bytes(const long long v)
-  {
-    size_t bytes_len = sizeof(long long);
-    std::vector<unsigned char> bytes;
-    for (size_t i = 0; i < bytes_len; i++)
+    else if (v <= 0xFFFF)
     {
-      bytes.push_back((v >> 8 * (7 - i)) & 0xFF);
+      return 3;
     }
-    int n = 1;
-    // little endian if true
-    if (*(char *)&n == 1)
+    else if (v <= 0xFFFFFFFF)
     {
-      std::reverse(std::begin(bytes), std::end(bytes));
+      return 5;
     }
-    return bytes;
+    return 9;
   }
 
-  std::vector<unsigned char> int2bytes(const int v)
+  static size_t varBytesSize(size_t len)
   {
-    size_t bytes_len = sizeof(int);
-    std::vector<unsigned char> bytes;
-    for (size_t i = 0; i < bytes_len; i++)
-    {
-      bytes.push_back((v >> 8 * (7 - i)) & 0xFF);
-    }
-    int n = 1;
-    // little endian if true
-    if (*(char *)&n == 1)
-    {
-      std::reverse(std::begin(bytes), std::end(bytes));
-    }
-    return bytes;
+    return varIntSize((long long)len) + len;
   }
 
-  std::vector<unsigned char> short2bytes(const short v)
+  template <class T>
+  static size_t serializableArraySize(std::vector<T> &t_vec)
   {
-    size_t bytes_len = sizeof(short);
-    std::vector<unsigned char> bytes;
-    for (size_t i = 0; i < bytes_len; i++)
+    size_t sz = varIntSize((long long)t_vec.size());
+    for (size_t i = 0; i < t_vec.size(); i++)
     {
-      bytes.push_back((v >> 8 * (7 - i)) & 0xFF);
+      sz += t_vec[i].serializedSize();
     }
-    int n = 1;
-    // little endian if true
-    if (*(char *)&n == 1)
-    {
-      std::reverse(std::begin(bytes), std::end(bytes));
-    }
-    return bytes;
+    return sz;
   }
 
-public:
-  BinaryWriter() {}
-
-  std::vector<unsigned char> toByteArray() { return uc_vec; }
-
   void write(const std::vector<unsigned char> &buffer)
   {
     uc_vec.insert(uc_vec.end(), buffer.begin(), buffer.end());
   }
 
-  void writeBool(bool v)
+  void write(const unsigned char *buffer, size_t len)
   {
-    if (sizeof(bool) != 1)
-    {
-      throw std::runtime_error("IOException");
-    }
-    unsigned char v_uc = v ? 1 : 0;
-    uc_vec.push_back(v_uc);
+    uc_vec.insert(uc_vec.end(), buffer, buffer + len);
   }
 
+  void writeBool(bool v) { uc_vec.push_back(v ? 1 : 0); }
+
   bool writeVarInt(long long v)
   {
     if (v < 0xFD)
     {
-      unsigned char buffer = v & 0xFF;
-      uc_vec.push_back(buffer);
+      uc_vec.push_back(v & 0xFF);
     }
     else if (v <= 0xFFFF)
     {
-      int bytes_len = 3;
-      unsigned char *bytes = new unsigned char[bytes_len];
-      long2bytes(v, bytes, bytes_len);
-      bytes[0] = 0xFD;
-      bytes_push_back(bytes, bytes_len);
-      delete[] bytes;
+      uc_vec.push_back(0xFD);
+      writeLE(v, 2);
     }
     else if (v <= 0xFFFFFFFF)
     {
-      int bytes_len = 5;
-      unsigned char *bytes = new unsigned char[bytes_len];
-      long2bytes(v, bytes, bytes_len);
-      bytes[0] = 0xFE;
-      bytes_push_back(bytes, bytes_len);
-      delete[] bytes;
+      uc_vec.push_back(0xFE);
+      writeLE(v, 4);
     }
     else
     {
-      int bytes_len = 9;
-      unsigned char *bytes = new unsigned char[bytes_len];
-      long2bytes(v, bytes, bytes_len);
-      bytes[0] = 0xFF;
-      bytes_push_back(bytes, bytes_len);
-      delete[] bytes;
+      uc_vec.push_back(0xFF);
+      writeLE(v, 8);
     }
     return true;
   }
 
   void writeByte(unsigned char v) { uc_vec.push_back(v); }
 
-  void writeShort(short v)
-  {
-    if (sizeof(short) != 2)
-    {
-      throw std::runtime_error("IOException");
-    }
-    std::vector<unsigned char> bytes;
-    bytes = short2bytes(v);
-    uc_vec.insert(uc_vec.end(), bytes.begin(), bytes.end());
-  }
+  void writeShort(short v) { writeLE((unsigned short)v, 2); }
 
-  void writeInt(int v)
-  {
-    if (sizeof(int) != 4)
-    {
-      throw std::runtime_error("IOException");
-    }
-    std::vector<unsigned char> bytes;
-    bytes = int2bytes(v);
-    uc_vec.insert(uc_vec.end(), bytes.begin(), bytes.end());
-  }
+  void writeInt(int v) { writeLE((unsigned int)v, 4); }
 
-  void writeLong(long long v)
+  void writeLong(long long v) { writeLE(v, 8); }
+
+  bool writeVarBytes(const unsigned char *v, size_t len)
   {
-    if (sizeof(long long) != 8)
-    {
-      throw std::runtime_error("IOException");
-    }
-    std::vector<unsigned char> bytes;
-    bytes = long2bytes(v);
-    uc_vec.insert(uc_vec.end(), bytes.begin(), bytes.end());
+    writeVarInt((long long)len);
+    write(v, len);
+    return true;
   }
 
   bool writeVarBytes(const unsigned char *v)
   {
-    long long len = (strlen((char *)v) / sizeof(unsigned char));
-
-    if (!writeVarInt(len))
-    {
-      return false;
-    }
-
-    for (int i = 0; i < len; i++)
-    {
-      uc_vec.push_back(v[i]);
-    }
-    return true;
+    return writeVarBytes(v, strlen((const char *)v));
   }
 
   bool writeVarBytes(const std::vector<unsigned char> &_vec)
   {
-    long long len = _vec.size();
-
-    if (!writeVarInt(len))
-    {
-      return false;
-    }
-    uc_vec.insert(uc_vec.cend(), _vec.cbegin(), _vec.cend());
-    return true;
+    return writeVarBytes(_vec.data(), _vec.size());
   }
 
   bool writeVarBytes(const std::string &str)
   {
-    int str_len = str.length();
-    std::string utf8_str(str);
-    if (!writeVarInt(str_len))
-    {
-      return false;
-    }
-    if (!writeVarBytes((unsigned char *)str.c_str()))
-    {
-      return false;
-    }
-    return true;
+    return writeVarBytes((const unsigned char *)str.data(), str.size());
   }
 
-  bool writeVarString(const std::string &str)
+  bool writeVarString(const std::string &str) { return writeVarBytes(str); }
+
+  template <class T>
+  void writeSerializable(T &v) { v.serialize(this); }
+
+  template <class T>
+  bool writeSerializableArray(std::vector<T> &t_vec)
   {
-    int str_len = str.length();
-    ;
-    if (!writeVarInt(str_len))
+    writeVarInt((long long)t_vec.size());
+    for (size_t i = 0; i < t_vec.size(); i++)
     {
-      return false;
-    }
-    if (!writeVarBytes((unsigned char *)str.c_str()))
-    {
-      return false;
+      t_vec[i].serialize(this);
     }
     return true;
   }
 
-  template <class T>
-  void writeSerializable(T &v) { v.serialize(this); }
-
   template <class T>
   bool writeSerializableArray(const std::vector<T> &t_vec)
   {
-    size_t sz = t_vec.size();
-    if (!writeVarInt((int)sz))
-    {
-      return false;
-    }
-    for (size_t i = 0; i < sz; i++)
+    writeVarInt((long long)t_vec.size());
+    for (size_t i = 0; i < t_vec.size(); i++)
     {
-      T t_item;
-      t_item = t_vec[i];
+      T t_item(t_vec[i]);
       t_item.serialize(this);
     }
     return true;
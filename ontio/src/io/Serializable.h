@@ -19,10 +19,12 @@ protected:
 public:
   virtual void serialize(BinaryWriter *writer) = 0;
   virtual void deserialize(BinaryReader *reader) = 0;
+  // exact number of bytes serialize() writes
+  virtual size_t serializedSize() = 0;
 
   std::vector<unsigned char> toArray()
   {
-    BinaryWriter writer;
+    BinaryWriter writer(serializedSize());
     try
     {
       serialize(&writer);
@@ -32,7 +34,7 @@ public:
       cerr << ex << endl;
       throw "UnsupportedOperationException(ex)";
     }
-    return writer.toByteArray();
+    return std::move(writer).take();
   }
 
   std::string toHexString()
@@ -0,0 +1,326 @@
+#ifndef NETWORK_CONNECT_CURLMULTILOOP_H
+#define NETWORK_CONNECT_CURLMULTILOOP_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <curl/curl.h>
+
+// Non-blocking HTTP for the SDK: one thread drives a curl_multi handle and
+// any number of transfers on it. Submitting never blocks; the result is
+// delivered to a callback on the loop thread or through a future. The
+// multi handle keeps finished connections open and hands them to the next
+// transfer to the same host, and easy handles are recycled, so a steady
+// stream of requests opens no new connections.
+class CurlMultiLoop
+{
+public:
+  // error is null on success, body is the response body; runs on the loop
+  // thread, so it must not block. Exceptions it throws are dropped.
+  typedef std::function<void(std::exception_ptr error, std::string &body)>
+      Callback;
+
+private:
+  struct Transfer
+  {
+    std::string url;
+    std::string body;
+    bool post;
+    Callback callback;
+    std::string response;
+    char error[CURL_ERROR_SIZE];
+  };
+
+  long timeoutMs;
+  CURLM *multi;
+  curl_slist *headers;
+  std::mutex mutex;
+  std::deque<std::unique_ptr<Transfer>> pending;
+  std::atomic<bool> stopping;
+  std::atomic<size_t> inFlightCount;
+  // touched by the loop thread only
+  std::unordered_map<CURL *, std::unique_ptr<Transfer>> active;
+  std::vector<CURL *> idle;
+  std::thread loop;
+
+  static size_t WriteCallback(void *contents, size_t size, size_t nmemb,
+                              void *userp)
+  {
+    ((std::string *)userp)->append((char *)contents, size * nmemb);
+    return size * nmemb;
+  }
+
+  static void notify(Transfer &transfer, std::exception_ptr error)
+  {
+    try
+    {
+      transfer.callback(error, transfer.response);
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void start(std::unique_ptr<Transfer> transfer)
+  {
+    CURL *curl;
+    if (idle.empty())
+    {
+      curl = curl_easy_init();
+      if (curl == NULL)
+      {
+        notify(*transfer, std::make_exception_ptr(
+                              std::runtime_error("curl_easy_init() failed.")));
+        inFlightCount--;
+        return;
+      }
+      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+      curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+      curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    }
+    else
+    {
+      curl = idle.back();
+      idle.pop_back();
+    }
+    bool is_https = transfer->url.compare(0, 5, "https") == 0;
+    transfer->error[0] = '\0';
+    curl_easy_setopt(curl, CURLOPT_URL, transfer->url.c_str());
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, is_https ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, is_https ? 2L : 0L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeoutMs);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&transfer->response);
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, transfer->error);
+    if (transfer->post)
+    {
+      curl_easy_setopt(curl, CURLOPT_POST, 1L);
+      curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE,
+                       (long)transfer->body.size());
+      curl_easy_setopt(curl, CURLOPT_POSTFIELDS, transfer->body.c_str());
+    }
+    else
+    {
+      curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+    }
+    active[curl] = std::move(transfer);
+    curl_multi_add_handle(multi, curl);
+  }
+
+  void finish(CURL *curl, CURLcode result)
+  {
+    curl_multi_remove_handle(multi, curl);
+    std::unordered_map<CURL *, std::unique_ptr<Transfer>>::iterator it =
+        active.find(curl);
+    std::unique_ptr<Transfer> transfer = std::move(it->second);
+    active.erase(it);
+    // the handle may be reused by whatever the callback submits
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, NULL);
+    idle.push_back(curl);
+    inFlightCount--;
+    std::exception_ptr error;
+    if (result != CURLE_OK)
+    {
+      std::string err = "curl_easy_perform() failed: ";
+      err.append(transfer->error[0] != '\0' ? transfer->error
+                                            : curl_easy_strerror(result));
+      error = std::make_exception_ptr(std::runtime_error(err));
+    }
+    notify(*transfer, error);
+  }
+
+  void run()
+  {
+    std::exception_ptr stopped = std::make_exception_ptr(
+        std::runtime_error("CurlMultiLoop stopped"));
+    for (;;)
+    {
+      std::deque<std::unique_ptr<Transfer>> submitted;
+      bool stop;
+      {
+        // submit() checks stopping under this lock too, so once it is seen
+        // here nothing can be left behind in pending
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted.swap(pending);
+        stop = stopping;
+      }
+      if (stop)
+      {
+        for (size_t i = 0; i < submitted.size(); i++)
+        {
+          inFlightCount--;
+          notify(*submitted[i], stopped);
+        }
+        while (!active.empty())
+        {
+          CURL *curl = active.begin()->first;
+          std::unique_ptr<Transfer> transfer =
+              std::move(active.begin()->second);
+          active.erase(active.begin());
+          curl_multi_remove_handle(multi, curl);
+          curl_easy_cleanup(curl);
+          inFlightCount--;
+          notify(*transfer, stopped);
+        }
+        return;
+      }
+      for (size_t i = 0; i < submitted.size(); i++)
+      {
+        start(std::move(submitted[i]));
+      }
+      int running = 0;
+      curl_multi_perform(multi, &running);
+      CURLMsg *msg;
+      int left = 0;
+      while ((msg = curl_multi_info_read(multi, &left)) != NULL)
+      {
+        if (msg->msg == CURLMSG_DONE)
+        {
+          finish(msg->easy_handle, msg->data.result);
+        }
+      }
+      curl_multi_poll(multi, NULL, 0, 1000, NULL);
+    }
+  }
+
+  void submit(std::unique_ptr<Transfer> transfer)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stopping)
+      {
+        throw std::runtime_error("CurlMultiLoop stopped");
+      }
+      inFlightCount++;
+      pending.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi);
+  }
+
+  static std::future<std::string> promised(std::unique_ptr<Transfer> &transfer)
+  {
+    std::shared_ptr<std::promise<std::string>> promise =
+        std::make_shared<std::promise<std::string>>();
+    transfer->callback = [promise](std::exception_ptr error,
+                                   std::string &body) {
+      if (error)
+      {
+        promise->set_exception(error);
+      }
+      else
+      {
+        promise->set_value(std::move(body));
+      }
+    };
+    return promise->get_future();
+  }
+
+public:
+  // timeout_ms bounds each transfer, connecting included.
+  // max_host_connections caps the connections to one host, further
+  // transfers wait for a free one; 0 leaves it to libcurl.
+  explicit CurlMultiLoop(long timeout_ms = 60000,
+                         long max_host_connections = 0)
+      : timeoutMs(timeout_ms), multi(NULL), headers(NULL), stopping(false),
+        inFlightCount(0)
+  {
+    // never undone, as in CurlPool
+    static const CURLcode global = curl_global_init(CURL_GLOBAL_ALL);
+    (void)global;
+    multi = curl_multi_init();
+    if (multi == NULL)
+    {
+      throw std::runtime_error("curl_multi_init() failed.");
+    }
+    if (max_host_connections > 0)
+    {
+      curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                        max_host_connections);
+    }
+    headers = curl_slist_append(
+        NULL, "Content-Type:application/json;charset=UTF-8");
+    loop = std::thread(&CurlMultiLoop::run, this);
+  }
+
+  CurlMultiLoop(const CurlMultiLoop &) = delete;
+  CurlMultiLoop &operator=(const CurlMultiLoop &) = delete;
+
+  // transfers still in flight fail with "CurlMultiLoop stopped"
+  ~CurlMultiLoop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    curl_multi_wakeup(multi);
+    loop.join();
+    for (size_t i = 0; i < idle.size(); i++)
+    {
+      curl_easy_cleanup(idle[i]);
+    }
+    curl_multi_cleanup(multi);
+    curl_slist_free_all(headers);
+  }
+
+  void post(const std::string &url, const std::string &body,
+            const Callback &callback)
+  {
+    std::unique_ptr<Transfer> transfer(new Transfer());
+    transfer->url = url;
+    transfer->body = body;
+    transfer->post = true;
+    transfer->callback = callback;
+    submit(std::move(transfer));
+  }
+
+  void get(const std::string &url, const Callback &callback)
+  {
+    std::unique_ptr<Transfer> transfer(new Transfer());
+    transfer->url = url;
+    transfer->post = false;
+    transfer->callback = callback;
+    submit(std::move(transfer));
+  }
+
+  std::future<std::string> post(const std::string &url,
+                                const std::string &body)
+  {
+    std::unique_ptr<Transfer> transfer(new Transfer());
+    transfer->url = url;
+    transfer->body = body;
+    transfer->post = true;
+    std::future<std::string> result = promised(transfer);
+    submit(std::move(transfer));
+    return result;
+  }
+
+  std::future<std::string> get(const std::string &url)
+  {
+    std::unique_ptr<Transfer> transfer(new Transfer());
+    transfer->url = url;
+    transfer->post = false;
+    std::future<std::string> result = promised(transfer);
+    submit(std::move(transfer));
+    return result;
+  }
+
+  // submitted transfers whose callback has not run yet
+  size_t inFlight() const { return inFlightCount; }
+};
+
+#endif
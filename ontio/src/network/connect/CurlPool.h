@@ -0,0 +1,140 @@
+#ifndef NETWORK_CONNECT_CURLPOOL_H
+#define NETWORK_CONNECT_CURLPOOL_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <curl/curl.h>
+
+// Keep-alive curl easy handles, one per host per thread. A handle keeps
+// its connection, and its TLS session, open between requests, so only
+// the first call to a node pays for the TCP and TLS handshakes. The
+// handles live until their thread exits or clear() drops them; nothing is
+// shared between threads, so no locking is needed.
+class CurlPool
+{
+private:
+  struct Handle
+  {
+    CURL *curl;
+    curl_slist *headers;
+    std::string response;
+
+    Handle() : curl(curl_easy_init()), headers(NULL)
+    {
+      if (curl == NULL)
+      {
+        throw std::runtime_error("curl_easy_init() failed.");
+      }
+      headers = curl_slist_append(
+          NULL, "Content-Type:application/json;charset=UTF-8");
+      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
+      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+      curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+      curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10000L);
+      curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10000L);
+    }
+
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+
+    ~Handle()
+    {
+      curl_easy_cleanup(curl);
+      curl_slist_free_all(headers);
+    }
+  };
+
+  typedef std::unordered_map<std::string, std::unique_ptr<Handle>> HandleMap;
+
+  static size_t WriteCallback(void *contents, size_t size, size_t nmemb,
+                              void *userp)
+  {
+    ((std::string *)userp)->append((char *)contents, size * nmemb);
+    return size * nmemb;
+  }
+
+  static HandleMap &handles()
+  {
+    static thread_local HandleMap map;
+    return map;
+  }
+
+  // scheme://authority of url, the part a connection is tied to
+  static std::string hostOf(const std::string &url)
+  {
+    std::string::size_type begin = url.find("://");
+    begin = begin == std::string::npos ? 0 : begin + 3;
+    return url.substr(0, url.find('/', begin));
+  }
+
+  static Handle &handleFor(const std::string &url)
+  {
+    // libcurl counts global inits; this one is never undone, so handles
+    // cached on other threads stay usable whatever SDK objects go away
+    static const CURLcode global = curl_global_init(CURL_GLOBAL_ALL);
+    (void)global;
+    std::unique_ptr<Handle> &handle = handles()[hostOf(url)];
+    if (!handle)
+    {
+      handle.reset(new Handle());
+    }
+    return *handle;
+  }
+
+  static std::string perform(Handle &handle, const std::string &url,
+                             bool is_https)
+  {
+    CURL *curl = handle.curl;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, is_https ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, is_https ? 2L : 0L);
+    handle.response.clear();
+    CURLcode res = curl_easy_perform(curl);
+    if (res != CURLE_OK)
+    {
+      std::string err = "curl_easy_perform() failed: ";
+      err.append(curl_easy_strerror(res));
+      throw std::runtime_error(err);
+    }
+    std::string body;
+    body.swap(handle.response);
+    return body;
+  }
+
+public:
+  // the response body; throws std::runtime_error when the transfer fails
+  static std::string post(const std::string &url, const std::string &body,
+                          bool is_https)
+  {
+    Handle &handle = handleFor(url);
+    curl_easy_setopt(handle.curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(handle.curl, CURLOPT_POSTFIELDSIZE, (long)body.size());
+    curl_easy_setopt(handle.curl, CURLOPT_POSTFIELDS, body.c_str());
+    return perform(handle, url, is_https);
+  }
+
+  static std::string get(const std::string &url, bool is_https)
+  {
+    Handle &handle = handleFor(url);
+    curl_easy_setopt(handle.curl, CURLOPT_HTTPGET, 1L);
+    return perform(handle, url, is_https);
+  }
+
+  // handles cached for the calling thread
+  static size_t size() { return handles().size(); }
+
+  // closes the calling thread's connections
+  static void clear() { handles().clear(); }
+};
+
+#endif
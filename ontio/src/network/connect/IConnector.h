@@ -6,6 +6,7 @@
 #endif
 
 #include <string>
+#include <vector>
 
 #include "boost/any.hpp"
 #include "nlohmann/json.hpp"
@@ -32,6 +33,34 @@ public:
                                    const std::string &from,
                                    const std::string &to) = 0;
   virtual std::string getVersion() = 0;
+
+  // result[i] answers addresses[i] or heights[i]. Connectors that can
+  // batch requests override these; the defaults make one call each.
+  virtual std::vector<nlohmann::json>
+  getBalanceBatch(const std::vector<std::string> &addresses)
+  {
+    std::vector<nlohmann::json> balances;
+    balances.reserve(addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+      balances.push_back(getBalance(addresses[i]));
+    }
+    return balances;
+  }
+
+  virtual std::vector<nlohmann::json>
+  getBlockJsonBatch(const std::vector<int> &heights)
+  {
+    std::vector<nlohmann::json> blocks;
+    blocks.reserve(heights.size());
+    for (size_t i = 0; i < heights.size(); i++)
+    {
+      blocks.push_back(getBlockJson(heights[i]));
+    }
+    return blocks;
+  }
+
+  virtual ~IConnector() {}
 };
 
 #endif
\ No newline at end of file
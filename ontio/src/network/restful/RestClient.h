@@ -0,0 +1,161 @@
+#ifndef NETWORK_RESTFUL_RESTCLIENT_H
+#define NETWORK_RESTFUL_RESTCLIENT_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "../../network/connect/IConnector.h"
+#include "RestfulInterfaces.h"
+
+// IConnector over the node's RESTful API, on the same keep-alive
+// transport as RpcClient. A response whose Error is not 0 (SUCCESS) and a
+// Result of the wrong type throw std::runtime_error.
+class RestClient : public IConnector
+{
+private:
+  Interfaces rest;
+  std::string version = "1.0.0";
+  std::string action = "sendrawtransaction";
+
+  static nlohmann::json result(const Result &response)
+  {
+    if (!response.ok())
+    {
+      throw std::runtime_error("RestfulException: " + response.result.Action +
+                               " " + std::to_string(response.result.Error) +
+                               " " + response.result.Desc);
+    }
+    return response.result.Result;
+  }
+
+  static int toInt(const Result &response)
+  {
+    nlohmann::json value = result(response);
+    if (!value.is_number())
+    {
+      throw std::runtime_error("RestfulException: " + response.result.Action +
+                               ": result is not a number");
+    }
+    return value.get<int>();
+  }
+
+  static std::string toString(const Result &response)
+  {
+    nlohmann::json value = result(response);
+    if (!value.is_string())
+    {
+      throw std::runtime_error("RestfulException: " + response.result.Action +
+                               ": result is not a string");
+    }
+    return value.get<std::string>();
+  }
+
+  static std::string withoutPrefix(const std::string &sData)
+  {
+    return sData.compare(0, 2, "0x") == 0 ? sData.substr(2) : sData;
+  }
+
+public:
+  RestClient() : rest(std::string()) {}
+  RestClient(const std::string &url) : rest(url) {}
+
+  void setUrl(const std::string &url) { rest.setUrl(url); }
+
+  std::string getUrl() override { return rest.getUrl(); }
+
+  nlohmann::json getBalance(std::string address) override
+  {
+    return result(rest.getBalance(address));
+  }
+
+  nlohmann::json sendRawTransaction(bool preExec, const std::string &userid,
+                                    const std::string &sData) override
+  {
+    return result(rest.sendTransaction(preExec, userid, action, version,
+                                       withoutPrefix(sData)));
+  }
+
+  // the transaction hash
+  nlohmann::json sendRawTransaction(const std::string &sData) override
+  {
+    return toString(rest.sendTransaction(false, "", action, version,
+                                         withoutPrefix(sData)));
+  }
+
+  int getGenerateBlockTime() override
+  {
+    return toInt(rest.getGenerateBlockTime());
+  }
+
+  int getNodeCount() override { return toInt(rest.getNodeCount()); }
+
+  int getBlockHeight() override { return toInt(rest.getBlockHeight()); }
+
+  nlohmann::json getBlockJson(int index) override
+  {
+    return result(rest.getBlock(index, false));
+  }
+
+  nlohmann::json getBlockJson(const std::string &hash) override
+  {
+    return result(rest.getBlock(hash, false));
+  }
+
+  nlohmann::json getContractJson(const std::string &hash) override
+  {
+    return result(rest.getContract(hash));
+  }
+
+  int getBlockHeightByTxHash(const std::string &hash) override
+  {
+    return toInt(rest.getBlockHeightByTxHash(hash));
+  }
+
+  std::string getStorage(const std::string &codehash,
+                         const std::string &key) override
+  {
+    return toString(rest.getStorage(codehash, key));
+  }
+
+  std::string getAllowance(const std::string &asset, const std::string &from,
+                           const std::string &to) override
+  {
+    return toString(rest.getAllowance(asset, from, to));
+  }
+
+  std::string getVersion() override { return toString(rest.getVersion()); }
+
+  nlohmann::json getTransactionJson(const std::string &txhash)
+  {
+    return result(rest.getTransaction(txhash, false));
+  }
+
+  // the transaction as hex
+  std::string getRawTransaction(const std::string &txhash)
+  {
+    return toString(rest.getTransaction(txhash, true));
+  }
+
+  nlohmann::json getSmartCodeEvent(int height)
+  {
+    return result(rest.getSmartCodeEvent(height));
+  }
+
+  nlohmann::json getSmartCodeEvent(const std::string &hash)
+  {
+    return result(rest.getSmartCodeEvent(hash));
+  }
+
+  nlohmann::json getMerkleProof(const std::string &hash)
+  {
+    return result(rest.getMerkleProof(hash));
+  }
+};
+
+#endif
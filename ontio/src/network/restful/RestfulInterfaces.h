@@ -5,98 +5,150 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 
+#include "Result.h"
 #include "UrlConsts.h"
 #include "http.h"
 
+// The node's RESTful API, one method per UrlConsts path. Requests go over
+// the calling thread's keep-alive connection to the node. Every method
+// returns the parsed response, whatever its Error; transport failures and
+// bodies that are not a response throw std::runtime_error.
 class Interfaces : public UrlConsts, public Http
 {
 private:
+  typedef std::unordered_map<std::string, std::string> Params;
+
   std::string url;
 
+  static Params rawParams(bool raw)
+  {
+    Params params;
+    params.insert({std::string("raw"), std::string(raw ? "1" : "0")});
+    return params;
+  }
+
+  Result query(const std::string &path, const Params &params = Params())
+  {
+    std::string response_body;
+    try
+    {
+      response_body = Http::get(url + path, params);
+    }
+    catch (const std::string &err)
+    {
+      throw std::runtime_error("RestfulException: ConnectUrlErr " + url +
+                               ": " + err);
+    }
+    return Result::parse(response_body);
+  }
+
 public:
   Interfaces(std::string _url) { url = _url; }
   std::string getUrl() { return url; }
+  void setUrl(const std::string &_url) { url = _url; }
 
-  // std::string sendTransaction(bool preExec, std::string userid,
-  //                             std::string action, std::string version,
-  //                             std::string data)
-  // {
-  //   std::unordered_map<std::string, std::string> params;
-  //   if (userid != NULL)
-  //   {
-  //     params.insert({std::string("userid"), userid});
-  //   }
-  //   if (preExec)
-  //   {
-  //     params.insert({std::string("preExec"), std::string("1")});
-  //   }
-  //   std::unordered_map<std::string, std::string> body;
-  //   body.insert({"Action", action});
-  //   body.insert({"Version", version});
-  //   body.insert({"Data", data});
-  //   try
-  //   {
-  //     Http http;
-  //     UrlConsts::Url UrlConsts urlconsts;
-  //     http.post(url + urlconsts.Url_send_transaction, params, body);
-  //   }
-  // }
-
-  std::string sendTransaction(bool preExec, std::string userid,
-                              std::string action, std::string version,
-                              std::string data)
+  Result sendTransaction(bool preExec, std::string userid, std::string action,
+                         std::string version, std::string data)
   {
-    nlohmann::json params = nlohmann::json::array();
+    Params params;
     if (!userid.empty())
     {
-      params.push_back({"userid", userid});
+      params.insert({std::string("userid"), userid});
     }
     if (preExec)
     {
-      params.push_back({"preEcec", 1});
+      params.insert({std::string("preExec"), std::string("1")});
     }
-    nlohmann::json body = nlohmann::json::array();
-    body = {{"Action", action}, {"Version", version}, {"Data", data}};
+    Params body;
+    body.insert({std::string("Action"), action});
+    body.insert({std::string("Version"), version});
+    body.insert({std::string("Data"), data});
     std::string response_body;
     try
     {
-      response_body = Http::curl_post_set_body(url + UrlConsts::Url_send_transaction,
-                                         params, body, is_https);
+      response_body =
+          Http::post(url + UrlConsts::Url_send_transaction, params, body);
     }
-    catch (const char *err)
+    catch (const std::string &err)
     {
-      cerr << err << endl;
+      throw std::runtime_error("RestfulException: ConnectUrlErr " + url +
+                               ": " + err);
     }
-    return response_body;
+    return Result::parse(response_body);
   }
 
-  std::string getTransaction(std::string txhash, bool raw)
+  // raw: the transaction as hex rather than JSON
+  Result getTransaction(std::string txhash, bool raw)
   {
-    nlohmann::json params = nlohmann::json::array();
-    if (raw)
-    {
-      params.push_back({"raw", 1});
-    }
-    try
-    {
-      std::string response_body = "";
-      CURLcode res;
-      res = Http::curl_get_body(url +, response_body, false);
-      cout << "res:\n"
-           << res << endl;
-      cout << "response_body:\n"
-           << response_body << endl;
-      return Http::get(url + UrlConsts::Url_get_transaction + txhash, params);
-    }
-    catch (const char *err)
-    {
-      cerr << err << endl;
-      throw "RestfulException(ErrorCode.ConnectUrlErr + url, e)";
-    }
+    return query(UrlConsts::Url_get_transaction + txhash, rawParams(raw));
+  }
+
+  Result getGenerateBlockTime()
+  {
+    return query(UrlConsts::Url_get_generate_block_time);
+  }
+
+  Result getNodeCount() { return query(UrlConsts::Url_get_node_count); }
+
+  Result getBlockHeight() { return query(UrlConsts::Url_get_block_height); }
+
+  Result getBlock(int height, bool raw)
+  {
+    return query(UrlConsts::Url_get_block_by_height + std::to_string(height),
+                 rawParams(raw));
   }
+
+  Result getBlock(std::string hash, bool raw)
+  {
+    return query(UrlConsts::Url_get_block_by_hash + hash, rawParams(raw));
+  }
+
+  Result getBalance(std::string address)
+  {
+    return query(UrlConsts::Url_get_account_balance + address);
+  }
+
+  Result getContract(std::string hash)
+  {
+    return query(UrlConsts::Url_get_contract_state + hash);
+  }
+
+  Result getSmartCodeEvent(int height)
+  {
+    return query(UrlConsts::Url_get_smartcodeevent_txs_by_height +
+                 std::to_string(height));
+  }
+
+  Result getSmartCodeEvent(std::string hash)
+  {
+    return query(UrlConsts::Url_get_smartcodeevent_by_txhash + hash);
+  }
+
+  Result getBlockHeightByTxHash(std::string hash)
+  {
+    return query(UrlConsts::Url_get_block_height_by_txhash + hash);
+  }
+
+  Result getStorage(std::string codehash, std::string key)
+  {
+    return query(UrlConsts::Url_get_storage + codehash + "/" + key);
+  }
+
+  Result getMerkleProof(std::string hash)
+  {
+    return query(UrlConsts::Url_get_merkleproof + hash);
+  }
+
+  Result getAllowance(std::string asset, std::string from, std::string to)
+  {
+    return query(UrlConsts::Url_get_allowance + asset + "/" + from + "/" + to);
+  }
+
+  Result getVersion() { return query(UrlConsts::Url_get_version); }
 };
 
 #endif
\ No newline at end of file
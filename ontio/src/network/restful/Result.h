@@ -5,30 +5,64 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <stdexcept>
 #include <string>
 
 #include <boost/any.hpp>
 #include <nlohmann/json.hpp>
 
+// the envelope of every RESTful API response; Result is whatever the call
+// returns: a number, a string, an object or null
 struct struct_result
 {
   std::string Action;
   long long Error;
   std::string Desc;
   std::string Version;
-  std::string Result;
+  nlohmann::json Result;
 };
 
 class Result
 {
 public:
   struct_result result;
+
+  Result() { result.Error = 0; }
+
+  // parses a response body, throws std::runtime_error if it is not one
+  static Result parse(const std::string &body)
+  {
+    Result response;
+    try
+    {
+      nlohmann::json json_result = nlohmann::json::parse(body);
+      response.result.Action = json_result.at("Action").get<std::string>();
+      response.result.Error = json_result.at("Error").get<long long>();
+      response.result.Desc = json_result.value("Desc", std::string());
+      response.result.Version = json_result.value("Version", std::string());
+      nlohmann::json::iterator it = json_result.find("Result");
+      if (it != json_result.end())
+      {
+        response.result.Result = std::move(*it);
+      }
+    }
+    catch (const nlohmann::json::exception &)
+    {
+      throw std::runtime_error("RestfulException: response is not a result: " +
+                               body);
+    }
+    return response;
+  }
+
+  // Error 0 is SUCCESS
+  bool ok() const { return result.Error == 0; }
+
   std::string toString()
   {
     nlohmann::json json_result;
     json_result["Action"] = result.Action;
     json_result["Error"] = result.Error;
-    json_result["Desc"] = result.Error;
+    json_result["Desc"] = result.Desc;
     json_result["Version"] = result.Version;
     json_result["Result"] = result.Result;
     std::string str_result = json_result.dump();
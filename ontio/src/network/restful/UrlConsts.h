@@ -25,6 +25,8 @@ public:
   std::string Url_get_block_height_by_txhash = "/api/v1/block/height/txhash/";
   std::string Url_get_storage = "/api/v1/storage/";
   std::string Url_get_merkleproof = "/api/v1/merkleproof/";
+  std::string Url_get_allowance = "/api/v1/allowance/";
+  std::string Url_get_version = "/api/v1/version";
 };
 
 #endif
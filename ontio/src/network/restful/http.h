@@ -12,6 +12,8 @@
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 
+#include "../connect/CurlPool.h"
+
 using namespace std;
 
 class Http {
@@ -26,21 +28,20 @@ private:
     if (params.empty()) {
       return "";
     }
-    std::string str = "?";
-    CURL *curl = curl_easy_init();
-    if (curl) {
-      std::unordered_map<std::string, std::string>::const_iterator params_it;
-      for (params_it = params.cbegin(); params_it != params.cend();
-           params_it++) {
-        std::string key = params_it->first;
-        std::string value = params_it->second;
-        if (!value.empty()) {
-          value = std::string(
-              curl_easy_escape(curl, value.c_str(), value.length()));
+    std::string str;
+    std::unordered_map<std::string, std::string>::const_iterator params_it;
+    for (params_it = params.cbegin(); params_it != params.cend(); params_it++) {
+      str.append(str.empty() ? "?" : "&").append(params_it->first).append("=");
+      if (!params_it->second.empty()) {
+        // the handle argument is unused, as in curl_escape()
+        char *value = curl_easy_escape(NULL, params_it->second.c_str(),
+                                       (int)params_it->second.length());
+        if (value == NULL) {
+          throw std::string("curl_easy_escape() failed.");
         }
-        str.append("&").append(key).append("=").append(value);
+        str.append(value);
+        curl_free(value);
       }
-      curl_easy_cleanup(curl);
     }
     return str;
   }
@@ -48,108 +49,30 @@ private:
 public:
   Http() { curl_global_init(CURL_GLOBAL_ALL); }
   ~Http() { curl_global_cleanup(); }
-  // http GET
+  // http GET, on the calling thread's keep-alive handle for the host
   CURLcode curl_get_body(const std::string &url, std::string &response_body,
                          bool is_https) {
-    CURL *curl = curl_easy_init();
-    std::string response_write;
-    std::string response_head;
     response_body.clear();
-    CURLcode res;
-    if (curl) {
-      // set params
-      curl_slist *plist = curl_slist_append(
-          NULL, "Content-Type:application/json;charset=UTF-8");
-      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, plist);
-      if (is_https) {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, true);
-      }
-
-      else {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
-      }
-      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-      curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
-      curl_easy_setopt(curl, CURLOPT_READFUNCTION, NULL);
-      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response_write);
-      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response_head);
-      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
-      curl_easy_setopt(curl, CURLOPT_HEADER, 1);
-      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10000);
-      curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10000);
-      res = curl_easy_perform(curl);
-      if (res != CURLE_OK) {
-        std::string err_str = "curl_easy_perform() failed: ";
-        err_str.append(curl_easy_strerror(res));
-        throw err_str;
-      }
-    } else {
-      throw "curl_easy_init() failed.";
+    try {
+      response_body = CurlPool::get(url, is_https);
+    } catch (const std::runtime_error &err) {
+      throw std::string(err.what());
     }
-    response_body =
-        response_write.substr(response_head.size(), response_write.size());
-    // release curl
-    curl_easy_cleanup(curl);
-    return res;
+    return CURLE_OK;
   }
 
-  // http POST
+  // http POST, on the calling thread's keep-alive handle for the host;
+  // postParams is sent as the body when post_body is empty, as in
+  // RpcInterfaces
   std::string curl_post_set_body(const std::string &url,
                                  const std::string &postParams,
                                  const std::string &post_body, bool is_https) {
-    // init curl
-    CURL *curl = curl_easy_init();
-    std::string response_write;
-    std::string response_head;
-    // res code
-    CURLcode res;
-    if (curl) {
-      // set params
-      curl_slist *plist = curl_slist_append(
-          NULL, "Content-Type:application/json;charset=UTF-8");
-      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, plist);
-      if (is_https) {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, true);
-      }
-
-      else {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
-      }
-      curl_easy_setopt(curl, CURLOPT_POST, 1);
-      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-      curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postParams.c_str());
-      curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
-      curl_easy_setopt(curl, CURLOPT_READFUNCTION, NULL);
-      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response_write);
-      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response_head);
-      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
-      curl_easy_setopt(curl, CURLOPT_HEADER, 1);
-      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10000);
-      curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10000);
-      curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_body.c_str());
-      res = curl_easy_perform(curl);
-      if (res != CURLE_OK) {
-        std::string err_str = "curl_easy_perform() failed: ";
-        err_str.append(curl_easy_strerror(res));
-        throw err_str;
-      }
-    } else {
-      throw "curl_easy_init() failed.";
+    try {
+      return CurlPool::post(url, post_body.empty() ? postParams : post_body,
+                            is_https);
+    } catch (const std::runtime_error &err) {
+      throw std::string(err.what());
     }
-    std::string response_body;
-    response_body =
-        response_write.substr(response_head.size(), response_write.size());
-    // release curl
-    curl_easy_cleanup(curl);
-    return response_body;
   }
 
   std::string
@@ -164,22 +87,23 @@ public:
     return str_uord_map;
   }
 
+  // GET url?params, throws std::string on transport errors
+  std::string get(std::string url,
+                  std::unordered_map<std::string, std::string> params) {
+    std::string response_body;
+    url.append(cvtParams(params));
+    curl_get_body(url, response_body, url.compare(0, 5, "https") == 0);
+    return response_body;
+  }
+
+  // POST body as a JSON object to url?params, throws std::string on
+  // transport errors
   std::string post(std::string url,
                    std::unordered_map<std::string, std::string> params,
                    std::unordered_map<std::string, std::string> body) {
-    std::string response_body;
-    try {
-      if (url.substr(0, 5) == "https") {
-        response_body = curl_post_set_body(url, cvtParams(params),
-                                           ToJSONString(body), true);
-      } else {
-        response_body = curl_post_set_body(url, cvtParams(params),
-                                           ToJSONString(body), false);
-      }
-    } catch (const char *e) {
-      std::cerr << e << std::endl;
-    }
-    return response_body;
+    url.append(cvtParams(params));
+    return curl_post_set_body(url, "", ToJSONString(body),
+                              url.compare(0, 5, "https") == 0);
   }
 };
 #endif
\ No newline at end of file
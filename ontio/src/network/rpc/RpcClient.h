@@ -40,6 +40,17 @@ public:
     return result;
   }
 
+  std::vector<nlohmann::json>
+  getBalanceBatch(const std::vector<std::string> &addresses) override {
+    std::vector<std::pair<std::string, nlohmann::json>> calls;
+    calls.reserve(addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++) {
+      calls.push_back(std::make_pair(std::string("getbalance"),
+                                     nlohmann::json::array({addresses[i]})));
+    }
+    return rpc.callBatch(calls);
+  }
+
   nlohmann::json sendRawTransaction(bool preExec, const std::string &userid,
                                     const std::string &sData) override {
     std::string cut_sData;
@@ -119,6 +130,17 @@ public:
     return result;
   }
 
+  std::vector<nlohmann::json>
+  getBlockJsonBatch(const std::vector<int> &heights) override {
+    std::vector<std::pair<std::string, nlohmann::json>> calls;
+    calls.reserve(heights.size());
+    for (size_t i = 0; i < heights.size(); i++) {
+      calls.push_back(std::make_pair(std::string("getblock"),
+                                     nlohmann::json::array({heights[i], 1})));
+    }
+    return rpc.callBatch(calls);
+  }
+
   nlohmann::json getBlockJson(const std::string &hash) override {
     nlohmann::json json_array = nlohmann::json::array();
     json_array.push_back(hash);
@@ -5,14 +5,20 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <iostream>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/any.hpp>
 #include <curl/curl.h>
+#include <nlohmann/json.hpp>
+
+#include "../connect/CurlPool.h"
 
 class RpcInterfaces
 {
@@ -38,7 +44,6 @@ private:
     nlohmann::json request = {
         {"jsonrpc", "2.0"}, {"method", method}, {"params", params}, {"id", 1}};
     std::string request_str = request.dump();
-    std::cout << "POST url=" + url + "," + request_str << std::endl;
     return request_str;
   }
 
@@ -48,7 +53,6 @@ private:
     nlohmann::json request = {
         {"jsonrpc", "2.0"}, {"method", method}, {"params", array}, {"id", 1}};
     std::string request_str = request.dump();
-    std::cout << "POST url=" + url + "," + request_str << std::endl;
     return request_str;
   }
 
@@ -87,160 +91,34 @@ private:
     return str;
   }
 
+  // http GET on the calling thread's keep-alive handle for the host
   CURLcode curl_get_body(const std::string &url, std::string &response_body,
                          bool is_https)
   {
-    CURL *curl = curl_easy_init();
-    std::string response_write;
-    std::string response_head;
-    response_body.clear();
-    CURLcode res;
-    if (curl)
+    try
     {
-      // set params
-      curl_slist *plist = curl_slist_append(
-          NULL, "Content-Type:application/json;charset=UTF-8");
-      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, plist);
-      if (is_https)
-      {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, true);
-      }
-
-      else
-      {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
-      }
-      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-      curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
-      curl_easy_setopt(curl, CURLOPT_READFUNCTION, NULL);
-      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response_write);
-      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response_head);
-      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
-      curl_easy_setopt(curl, CURLOPT_HEADER, 1);
-      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10000);
-      curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10000);
-      res = curl_easy_perform(curl);
-      if (res != CURLE_OK)
-      {
-        std::string err_str = "curl_easy_perform() failed: ";
-        err_str.append(curl_easy_strerror(res));
-        throw err_str;
-      }
+      response_body = CurlPool::get(url, is_https);
     }
-    else
+    catch (const std::runtime_error &err)
     {
-      throw "curl_easy_init() failed.";
+      throw std::string(err.what());
     }
-    response_body =
-        response_write.substr(response_head.size(), response_write.size());
-    // release curl
-    curl_easy_cleanup(curl);
-    return res;
+    return CURLE_OK;
   }
 
-  // http POST
+  // http POST on the calling thread's keep-alive handle for the host
   std::string curl_post_set_body(const std::string &url,
                                  const std::string &postParams,
                                  const std::string &post_body, bool is_https)
   {
-    // init curl
-    CURL *curl = curl_easy_init();
-    std::string response_write;
-    std::string response_head;
-    // res code
-    CURLcode res;
-    if (curl)
-    {
-      // set params
-      curl_slist *plist = curl_slist_append(
-          NULL, "Content-Type:application/json;charset=UTF-8");
-      curl_easy_setopt(curl, CURLOPT_HTTPHEADER, plist);
-      if (is_https)
-      {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, true);
-      }
-
-      else
-      {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
-      }
-      curl_easy_setopt(curl, CURLOPT_POST, 1);
-      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-      if (postParams.size() != 0)
-      {
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postParams.c_str());
-      }
-      curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
-      curl_easy_setopt(curl, CURLOPT_READFUNCTION, NULL);
-      curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response_write);
-      curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback);
-      curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response_head);
-      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
-      curl_easy_setopt(curl, CURLOPT_HEADER, 1);
-      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10000);
-      curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10000);
-      if (post_body.size() != 0)
-      {
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_body.c_str());
-      }
-      res = curl_easy_perform(curl);
-      if (res != CURLE_OK)
-      {
-        std::string err = "curl_easy_perform() failed: ";
-        err.append(curl_easy_strerror(res));
-        throw std::runtime_error(err);
-      }
-    }
-    else
-    {
-      throw std::runtime_error("curl_easy_init() failed.");
-    }
-    std::string response_body;
-    response_body =
-        response_write.substr(response_head.size(), response_write.size());
-    // release curl
-    curl_easy_cleanup(curl);
-    return response_body;
+    return CurlPool::post(url, post_body.empty() ? postParams : post_body,
+                          is_https);
   }
 
   std::string post(const std::string &url, const std::string &post_data,
                    bool is_https)
   {
-    CURL *curl;
-    CURLcode res;
-    std::string response_write;
-    std::string response_head;
-    /* get a curl handle */
-    curl = curl_easy_init();
-    if (curl)
-    {
-      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-      /* Now specify the POST data */
-      curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_data.c_str());
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response_write);
-      curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response_head);
-      /* Perform the request, res will get the return code */
-      res = curl_easy_perform(curl);
-      /* Check for errors */
-      if (res != CURLE_OK)
-      {
-        std::string err_str = "curl_easy_perform() failed: ";
-        err_str.append(curl_easy_strerror(res));
-        throw err_str;
-      }
-      /* always cleanup */
-      curl_easy_cleanup(curl);
-      std::string response_body;
-      response_body =
-          response_write.substr(response_head.size(), response_write.size());
-    }
+    return CurlPool::post(url, post_data, is_https);
   }
 
   std::string post(std::string url,
@@ -310,7 +188,6 @@ public:
       throw "RpcException(0,ErrorCode.ConnectUrlErr(  " + url +
           "response is null. maybe is connect error)";
     }
-    std::cout << json_response << std::endl;
     nlohmann::json::iterator it;
     it = json_response.find("error");
     if (it == json_response.end())
@@ -319,7 +196,6 @@ public:
     }
     if (*it != 0)
     {
-      std::cout << "error: " << *it << std::endl;
       throw "RpcException(0, JSON.toJSONString(response))";
     }
     it = json_response.find("result");
@@ -332,6 +208,78 @@ public:
     return ret_value;
   }
 
+  // One JSON-RPC 2.0 batch per max_batch calls instead of one round trip
+  // per call. calls[i] is a method and its params array, result[i] its
+  // result; responses are matched to calls by id, so the node may answer
+  // in any order. Throws if any call fails, as call() would.
+  std::vector<nlohmann::json>
+  callBatch(const std::vector<std::pair<std::string, nlohmann::json>> &calls,
+            size_t max_batch = 500)
+  {
+    std::vector<nlohmann::json> results(calls.size());
+    std::vector<bool> answered(calls.size(), false);
+    if (max_batch == 0)
+    {
+      max_batch = 1;
+    }
+    for (size_t begin = 0; begin < calls.size(); begin += max_batch)
+    {
+      size_t end = std::min(calls.size(), begin + max_batch);
+      nlohmann::json request = nlohmann::json::array();
+      for (size_t i = begin; i < end; i++)
+      {
+        request.push_back({{"jsonrpc", "2.0"},
+                           {"method", calls[i].first},
+                           {"params", calls[i].second},
+                           {"id", i + 1}});
+      }
+      nlohmann::json json_response = send(request.dump());
+      if (!json_response.is_array())
+      {
+        throw "RpcException(0, batch response is not an array)";
+      }
+      for (size_t r = 0; r < json_response.size(); r++)
+      {
+        const nlohmann::json &item = json_response[r];
+        nlohmann::json::const_iterator id = item.find("id");
+        if (!item.is_object() || id == item.end() ||
+            !id->is_number_unsigned())
+        {
+          throw "RpcException(0, batch response without id)";
+        }
+        size_t index = id->get<size_t>() - 1;
+        if (index < begin || index >= end || answered[index])
+        {
+          throw "RpcException(0, unexpected id in batch response)";
+        }
+        nlohmann::json::const_iterator it = item.find("error");
+        if (it == item.end())
+        {
+          throw "json_response.find(\"error\")== json_response.end()";
+        }
+        if (*it != 0)
+        {
+          throw "RpcException(0, JSON.toJSONString(response))";
+        }
+        it = item.find("result");
+        if (it == item.end())
+        {
+          throw "json_response.find(\"result\")== json_response.end()";
+        }
+        results[index] = *it;
+        answered[index] = true;
+      }
+      for (size_t i = begin; i < end; i++)
+      {
+        if (!answered[i])
+        {
+          throw "RpcException(0, batch response is missing a call)";
+        }
+      }
+    }
+    return results;
+  }
+
   nlohmann::json call(const std::string &method, const std::string &params)
   {
     nlohmann::json json_array;
@@ -345,7 +293,6 @@ public:
     request = makeRequest(method);
     nlohmann::json json_response;
     json_response = send(request);
-    std::cout << "json_response:" << json_response << std::endl;
     if (json_response.size() == 0)
     {
       throw "RpcException(0,ErrorCode.ConnectUrlErr(  " + url +
@@ -0,0 +1,352 @@
+#ifndef SDK_MANAGER_ASYNCCONNECTMGR_H
+#define SDK_MANAGER_ASYNCCONNECTMGR_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "../../network/connect/CurlMultiLoop.h"
+
+// The ConnectMgr operations over JSON-RPC without blocking the caller.
+// Every operation returns a future, or takes a callback that runs on the
+// loop thread once the node has answered and must not block. One loop
+// keeps hundreds of requests in flight from a single thread, and several
+// managers, one per node, may share it.
+//
+// RPC and transport failures are std::runtime_error, delivered through the
+// future or as the callback's exception_ptr.
+class AsyncConnectMgr
+{
+public:
+  template <class T>
+  struct Callback
+  {
+    typedef std::function<void(std::exception_ptr error, const T &result)>
+        type;
+  };
+
+private:
+  std::string url;
+  std::shared_ptr<CurlMultiLoop> loop;
+
+  // the result of a JSON-RPC response, or the node's error
+  static nlohmann::json result(const std::string &body)
+  {
+    nlohmann::json response;
+    try
+    {
+      response = nlohmann::json::parse(body);
+    }
+    catch (const nlohmann::json::exception &)
+    {
+      throw std::runtime_error("RpcException: response is not JSON: " + body);
+    }
+    nlohmann::json::const_iterator it = response.find("error");
+    if (it == response.end())
+    {
+      throw std::runtime_error("RpcException: response has no error field");
+    }
+    if (*it != 0)
+    {
+      throw std::runtime_error("RpcException: " + response.dump());
+    }
+    it = response.find("result");
+    if (it == response.end())
+    {
+      throw std::runtime_error("RpcException: response has no result field");
+    }
+    return *it;
+  }
+
+  static std::string requestBody(const std::string &method,
+                                 const nlohmann::json &params)
+  {
+    nlohmann::json request = {
+        {"jsonrpc", "2.0"}, {"method", method}, {"params", params}, {"id", 1}};
+    return request.dump();
+  }
+
+  static int toInt(const nlohmann::json &value)
+  {
+    if (!value.is_number())
+    {
+      throw std::runtime_error("RpcException: result is not a number");
+    }
+    return value.get<int>();
+  }
+
+  static std::string toString(const nlohmann::json &value)
+  {
+    if (!value.is_string())
+    {
+      throw std::runtime_error("RpcException: result is not a string");
+    }
+    return value.get<std::string>();
+  }
+
+  static nlohmann::json toJson(const nlohmann::json &value) { return value; }
+
+  // posts method(params) and hands convert(result) to callback
+  template <class T, class Convert>
+  void request(const std::string &method, const nlohmann::json &params,
+               Convert convert, const typename Callback<T>::type &callback)
+  {
+    loop->post(url, requestBody(method, params),
+               [convert, callback](std::exception_ptr error,
+                                   std::string &body) {
+                 T value = T();
+                 if (!error)
+                 {
+                   try
+                   {
+                     value = convert(result(body));
+                   }
+                   catch (...)
+                   {
+                     error = std::current_exception();
+                   }
+                 }
+                 callback(error, value);
+               });
+  }
+
+  template <class T, class Convert>
+  std::future<T> request(const std::string &method,
+                         const nlohmann::json &params, Convert convert)
+  {
+    std::shared_ptr<std::promise<T>> promise =
+        std::make_shared<std::promise<T>>();
+    request<T>(method, params, convert,
+               [promise](std::exception_ptr error, const T &value) {
+                 if (error)
+                 {
+                   promise->set_exception(error);
+                 }
+                 else
+                 {
+                   promise->set_value(value);
+                 }
+               });
+    return promise->get_future();
+  }
+
+  static nlohmann::json transactionParams(const std::string &hexData,
+                                          bool preExec)
+  {
+    nlohmann::json params = nlohmann::json::array();
+    params.push_back(hexData.compare(0, 2, "0x") == 0 ? hexData.substr(2)
+                                                      : hexData);
+    if (preExec)
+    {
+      params.push_back(1);
+    }
+    return params;
+  }
+
+  static nlohmann::json blockParams(const nlohmann::json &key)
+  {
+    return nlohmann::json::array({key, 1});
+  }
+
+public:
+  explicit AsyncConnectMgr(
+      const std::string &_url,
+      std::shared_ptr<CurlMultiLoop> _loop = std::shared_ptr<CurlMultiLoop>())
+      : url(_url), loop(_loop ? _loop : std::make_shared<CurlMultiLoop>())
+  {
+  }
+
+  std::string getUrl() const { return url; }
+
+  // any JSON-RPC method, with the raw result
+  std::future<nlohmann::json> call(const std::string &method,
+                                   const nlohmann::json &params)
+  {
+    return request<nlohmann::json>(method, params, toJson);
+  }
+
+  void call(const std::string &method, const nlohmann::json &params,
+            const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>(method, params, toJson, callback);
+  }
+
+  // true once the node accepted the transaction, false if it refused it
+  std::future<bool> sendRawTransaction(const std::string &hexData)
+  {
+    std::shared_ptr<std::promise<bool>> promise =
+        std::make_shared<std::promise<bool>>();
+    sendRawTransaction(hexData,
+                       [promise](std::exception_ptr error, const bool &ok) {
+                         if (error)
+                         {
+                           promise->set_exception(error);
+                         }
+                         else
+                         {
+                           promise->set_value(ok);
+                         }
+                       });
+    return promise->get_future();
+  }
+
+  void sendRawTransaction(const std::string &hexData,
+                          const Callback<bool>::type &callback)
+  {
+    loop->post(url,
+               requestBody("sendrawtransaction",
+                           transactionParams(hexData, false)),
+               [callback](std::exception_ptr error, std::string &body) {
+                 bool ok = false;
+                 if (!error)
+                 {
+                   try
+                   {
+                     result(body);
+                     ok = true;
+                   }
+                   catch (const std::runtime_error &)
+                   {
+                     // a well formed refusal, as ConnectMgr reports it
+                     ok = false;
+                   }
+                 }
+                 callback(error, ok);
+               });
+  }
+
+  std::future<nlohmann::json>
+  sendRawTransactionPreExec(const std::string &hexData)
+  {
+    return request<nlohmann::json>("sendrawtransaction",
+                                   transactionParams(hexData, true), toJson);
+  }
+
+  void sendRawTransactionPreExec(const std::string &hexData,
+                                 const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>("sendrawtransaction",
+                            transactionParams(hexData, true), toJson,
+                            callback);
+  }
+
+  std::future<int> getNodeCount()
+  {
+    return request<int>("getconnectioncount", nlohmann::json::array(), toInt);
+  }
+
+  void getNodeCount(const Callback<int>::type &callback)
+  {
+    request<int>("getconnectioncount", nlohmann::json::array(), toInt,
+                 callback);
+  }
+
+  std::future<int> getBlockHeight()
+  {
+    return request<int>("getblockcount", nlohmann::json::array(), toInt);
+  }
+
+  void getBlockHeight(const Callback<int>::type &callback)
+  {
+    request<int>("getblockcount", nlohmann::json::array(), toInt, callback);
+  }
+
+  std::future<nlohmann::json> getBlockJson(int index)
+  {
+    return request<nlohmann::json>("getblock", blockParams(index), toJson);
+  }
+
+  void getBlockJson(int index, const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>("getblock", blockParams(index), toJson, callback);
+  }
+
+  std::future<nlohmann::json> getBlockJson(const std::string &hash)
+  {
+    return request<nlohmann::json>("getblock", blockParams(hash), toJson);
+  }
+
+  void getBlockJson(const std::string &hash,
+                    const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>("getblock", blockParams(hash), toJson, callback);
+  }
+
+  std::future<nlohmann::json> getContractJson(const std::string &hash)
+  {
+    return request<nlohmann::json>("getcontractstate", blockParams(hash),
+                                   toJson);
+  }
+
+  void getContractJson(const std::string &hash,
+                       const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>("getcontractstate", blockParams(hash), toJson,
+                            callback);
+  }
+
+  std::future<nlohmann::json> getBalance(const std::string &address)
+  {
+    return request<nlohmann::json>(
+        "getbalance", nlohmann::json::array({address}), toJson);
+  }
+
+  void getBalance(const std::string &address,
+                  const Callback<nlohmann::json>::type &callback)
+  {
+    request<nlohmann::json>("getbalance", nlohmann::json::array({address}),
+                            toJson, callback);
+  }
+
+  std::future<int> getBlockHeightByTxHash(const std::string &hash)
+  {
+    return request<int>("getblockheightbytxhash",
+                        nlohmann::json::array({hash}), toInt);
+  }
+
+  void getBlockHeightByTxHash(const std::string &hash,
+                              const Callback<int>::type &callback)
+  {
+    request<int>("getblockheightbytxhash", nlohmann::json::array({hash}),
+                 toInt, callback);
+  }
+
+  std::future<std::string> getStorage(const std::string &codehash,
+                                      const std::string &key)
+  {
+    return request<std::string>(
+        "getstorage", nlohmann::json::array({codehash, key}), toString);
+  }
+
+  void getStorage(const std::string &codehash, const std::string &key,
+                  const Callback<std::string>::type &callback)
+  {
+    request<std::string>("getstorage", nlohmann::json::array({codehash, key}),
+                         toString, callback);
+  }
+
+  std::future<std::string> getAllowance(const std::string &asset,
+                                        const std::string &from,
+                                        const std::string &to)
+  {
+    return request<std::string>(
+        "getallowance", nlohmann::json::array({asset, from, to}), toString);
+  }
+
+  std::future<std::string> getVersion()
+  {
+    return request<std::string>("getversion", nlohmann::json::array(),
+                                toString);
+  }
+};
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef SDK_MANAGER_COCONNECTMGR_H
+#define SDK_MANAGER_COCONNECTMGR_H
+
+#if __cplusplus < 202002L
+#error "use --std=c++20 option for compile."
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "../../common/Coroutine.h"
+#include "AsyncConnectMgr.h"
+
+// co_await-able ConnectMgr operations. Each one is an AsyncConnectMgr
+// request on the shared curl_multi loop, so a suspended coroutine holds no
+// thread; when the node answers, the executor decides where it resumes.
+//
+//   Task<int> confirmations(CoConnectMgr &node, std::string tx,
+//                           std::string txhash) {
+//     if (!co_await node.sendRawTransaction(tx))
+//       co_return -1;
+//     int height = co_await node.getBlockHeight();
+//     co_return height - co_await node.getBlockHeightByTxHash(txhash);
+//   }
+//
+// Failures are rethrown from co_await as std::runtime_error.
+class CoConnectMgr
+{
+public:
+  // what co_await on an operation suspends on
+  template <class T> class Awaitable
+  {
+  private:
+    typedef typename AsyncConnectMgr::Callback<T>::type Callback;
+
+    std::function<void(const Callback &)> start;
+    std::shared_ptr<CoExecutor> executor;
+    T value;
+    std::exception_ptr error;
+
+  public:
+    Awaitable(std::function<void(const Callback &)> _start,
+              std::shared_ptr<CoExecutor> _executor)
+        : start(std::move(_start)), executor(std::move(_executor)), value()
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      // the coroutine may be resumed, and this awaitable gone, before
+      // the request call returns, so nothing it runs may live in this
+      std::function<void(const Callback &)> request = std::move(start);
+      std::shared_ptr<CoExecutor> resume_on = executor;
+      request([this, handle, resume_on](std::exception_ptr _error,
+                                      const T &_value) {
+        error = _error;
+        value = _value;
+        resume_on->post([handle]() { handle.resume(); });
+      });
+    }
+
+    T await_resume()
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+      return std::move(value);
+    }
+  };
+
+private:
+  std::shared_ptr<AsyncConnectMgr> async;
+  std::shared_ptr<CoExecutor> executor;
+
+  template <class T, class F> Awaitable<T> awaitable(F start)
+  {
+    std::shared_ptr<AsyncConnectMgr> node = async;
+    return Awaitable<T>(
+        [node, start](const typename AsyncConnectMgr::Callback<T>::type &cb) {
+          start(*node, cb);
+        },
+        executor);
+  }
+
+public:
+  // By default coroutines resume inline on the network loop thread; pass a
+  // ThreadPoolExecutor when they do real work between requests.
+  explicit CoConnectMgr(
+      const std::string &url,
+      std::shared_ptr<CoExecutor> _executor = std::shared_ptr<CoExecutor>(),
+      std::shared_ptr<CurlMultiLoop> loop = std::shared_ptr<CurlMultiLoop>())
+      : async(std::make_shared<AsyncConnectMgr>(url, loop)),
+        executor(_executor ? _executor : std::make_shared<InlineExecutor>())
+  {
+  }
+
+  Awaitable<nlohmann::json> call(const std::string &method,
+                                 const nlohmann::json &params)
+  {
+    return awaitable<nlohmann::json>(
+        [method, params](AsyncConnectMgr &node, const auto &cb) {
+          node.call(method, params, cb);
+        });
+  }
+
+  Awaitable<bool> sendRawTransaction(const std::string &hexData)
+  {
+    return awaitable<bool>([hexData](AsyncConnectMgr &node, const auto &cb) {
+      node.sendRawTransaction(hexData, cb);
+    });
+  }
+
+  Awaitable<nlohmann::json>
+  sendRawTransactionPreExec(const std::string &hexData)
+  {
+    return awaitable<nlohmann::json>(
+        [hexData](AsyncConnectMgr &node, const auto &cb) {
+          node.sendRawTransactionPreExec(hexData, cb);
+        });
+  }
+
+  Awaitable<int> getNodeCount()
+  {
+    return awaitable<int>(
+        [](AsyncConnectMgr &node, const auto &cb) { node.getNodeCount(cb); });
+  }
+
+  Awaitable<int> getBlockHeight()
+  {
+    return awaitable<int>([](AsyncConnectMgr &node, const auto &cb) {
+      node.getBlockHeight(cb);
+    });
+  }
+
+  Awaitable<nlohmann::json> getBlockJson(int index)
+  {
+    return awaitable<nlohmann::json>(
+        [index](AsyncConnectMgr &node, const auto &cb) {
+          node.getBlockJson(index, cb);
+        });
+  }
+
+  Awaitable<nlohmann::json> getBlockJson(const std::string &hash)
+  {
+    return awaitable<nlohmann::json>(
+        [hash](AsyncConnectMgr &node, const auto &cb) {
+          node.getBlockJson(hash, cb);
+        });
+  }
+
+  Awaitable<nlohmann::json> getContractJson(const std::string &hash)
+  {
+    return awaitable<nlohmann::json>(
+        [hash](AsyncConnectMgr &node, const auto &cb) {
+          node.getContractJson(hash, cb);
+        });
+  }
+
+  Awaitable<nlohmann::json> getBalance(const std::string &address)
+  {
+    return awaitable<nlohmann::json>(
+        [address](AsyncConnectMgr &node, const auto &cb) {
+          node.getBalance(address, cb);
+        });
+  }
+
+  Awaitable<int> getBlockHeightByTxHash(const std::string &hash)
+  {
+    return awaitable<int>([hash](AsyncConnectMgr &node, const auto &cb) {
+      node.getBlockHeightByTxHash(hash, cb);
+    });
+  }
+
+  Awaitable<std::string> getStorage(const std::string &codehash,
+                                    const std::string &key)
+  {
+    return awaitable<std::string>(
+        [codehash, key](AsyncConnectMgr &node, const auto &cb) {
+          node.getStorage(codehash, key, cb);
+        });
+  }
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include <boost/any.hpp>
 
 #include "../../network/connect/IConnector.h"
+#include "../../network/restful/RestClient.h"
 #include "../../network/rpc/RpcClient.h"
 #include "ConnectType.h"
 
@@ -18,6 +19,7 @@ class ConnectMgr
 private:
   IConnector *connector;
   RpcClient rpc_client;
+  RestClient rest_client;
 
 public:
   ConnectMgr() {}
@@ -31,8 +33,8 @@ public:
     }
     else if (type == ConnectType::RESTful)
     {
-      // TODO
-      throw "ConnectMgr: ConnectType::RESTful";
+      rest_client.setUrl(_url);
+      connector = &rest_client;
     }
     else
     {
@@ -87,6 +89,19 @@ public:
     return block;
   }
 
+  // blocks at heights, in order, fetched in as few requests as the
+  // connector allows
+  std::vector<nlohmann::json> getBlockJsonBatch(const std::vector<int> &heights)
+  {
+    return connector->getBlockJsonBatch(heights);
+  }
+
+  std::vector<nlohmann::json>
+  getBalanceBatch(const std::vector<std::string> &addresses)
+  {
+    return connector->getBalanceBatch(addresses);
+  }
+
   nlohmann::json getBlockJson(const std::string &hash)
   {
     nlohmann::json block;
@@ -0,0 +1,84 @@
+#ifndef SIGNSERVICE_H
+#define SIGNSERVICE_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "../../account/Account.h"
+#include "../../common/Common.h"
+#include "../../common/ErrorCode.hpp"
+#include "../../common/ThreadPool.h"
+#include "../../core/asset/Sig.h"
+#include "../../core/payload/InvokeCodeTransaction.h"
+#include "../../crypto/Digest.h"
+#include "../exception/SDKException.h"
+
+// Signs InvokeCodeTransactions on a pool of worker threads. The signing
+// digest is cached on the transaction and the accounts share their parsed
+// EC keys, so nothing but the signatures is computed per transaction.
+class SignService
+{
+  private:
+    ThreadPool pool;
+
+  public:
+    // threads == 0 uses one worker per hardware thread
+    explicit SignService(size_t threads = 0) : pool(threads) {}
+
+    size_t threads() const { return pool.size(); }
+
+    // one single-key Sig per account over the cached signing digest
+    static void signTx(InvokeCodeTransaction &tx,
+                       const std::vector<Account> &accounts)
+    {
+        if (accounts.size() > Common::TX_MAX_SIG_SIZE)
+        {
+            throw SDKException(ErrorCode::StrParamErr(
+                "the number of transaction signatures should not be over 16"));
+        }
+        const Digest::Hash256 &sign_hash = tx.signHash();
+        std::vector<Sig> sigs;
+        sigs.reserve(accounts.size());
+        for (size_t i = 0; i < accounts.size(); i++)
+        {
+            Account account = accounts[i];
+            std::vector<unsigned char> pub_key = account.serializePublicKey();
+            std::vector<unsigned char> signature =
+                account.generateSignature(sign_hash.data(), sign_hash.size());
+            sigs.push_back(Sig(std::string(pub_key.begin(), pub_key.end()), 1,
+                               std::string(signature.begin(), signature.end())));
+        }
+        tx.add_sigs(sigs);
+    }
+
+    // the future holds the signed copy of tx, or the exception signing threw
+    std::future<InvokeCodeTransaction>
+    submit(const InvokeCodeTransaction &tx,
+           const std::vector<Account> &accounts)
+    {
+        return pool.submit([tx, accounts]() {
+            InvokeCodeTransaction signed_tx = tx;
+            signTx(signed_tx, accounts);
+            return signed_tx;
+        });
+    }
+
+    std::vector<std::future<InvokeCodeTransaction>>
+    submit(const std::vector<InvokeCodeTransaction> &txs,
+           const std::vector<Account> &accounts)
+    {
+        std::vector<std::future<InvokeCodeTransaction>> futures;
+        futures.reserve(txs.size());
+        for (size_t i = 0; i < txs.size(); i++)
+        {
+            futures.push_back(submit(txs[i], accounts));
+        }
+        return futures;
+    }
+};
+#endif // !SIGNSERVICE_H
@@ -0,0 +1,285 @@
+#ifndef SDK_MANAGER_UNLOCKEDKEYCACHE_H
+#define SDK_MANAGER_UNLOCKEDKEYCACHE_H
+
+#if __cplusplus < 201103L
+#error "use --std=c++11 option for compile."
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+
+#include "../../account/Account.h"
+#include "../../crypto/Digest.h"
+#include "../../crypto/ScryptHandler.h"
+
+// Decrypted private keys and scrypt derived keys of recently unlocked
+// accounts, so a hot account pays for scrypt once per ttl instead of on
+// every signature. Entries expire ttl after they were unlocked, whether
+// used or not, and the least recently used entry makes room once the
+// cache is full. Evicted, expired and cleared secrets are overwritten
+// before their memory is released.
+//
+// Entries are looked up by a salted SHA-256 of everything the secret was
+// derived from, password included; the salt is random per cache, so the
+// lookup ids are useless outside this process.
+class UnlockedKeyCache
+{
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Entry
+  {
+    std::string id;
+    // the account address for private keys, empty for derived keys
+    std::string address;
+    std::vector<unsigned char> secret;
+    Clock::time_point expires;
+  };
+
+  size_t capacity;
+  Clock::duration ttl;
+  unsigned char idSalt[32];
+  // most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index;
+  std::mutex mutex;
+
+  static void hashField(Sha256Context &ctx, const unsigned char *data,
+                        size_t len)
+  {
+    unsigned char size[4] = {(unsigned char)(len >> 24),
+                             (unsigned char)(len >> 16),
+                             (unsigned char)(len >> 8), (unsigned char)len};
+    ctx.update(size, sizeof(size)).update(data, len);
+  }
+
+  static void hashField(Sha256Context &ctx, const std::string &field)
+  {
+    hashField(ctx, (const unsigned char *)field.data(), field.size());
+  }
+
+  std::string derivedKeyId(const std::string &password,
+                           const std::vector<unsigned char> &salt, int n)
+  {
+    Sha256Context ctx;
+    ctx.update(idSalt, sizeof(idSalt));
+    hashField(ctx, "derived");
+    hashField(ctx, password);
+    hashField(ctx, salt.data(), salt.size());
+    hashField(ctx, std::to_string(n));
+    Digest::Hash256 id = ctx.final();
+    return std::string(id.begin(), id.end());
+  }
+
+  std::string privateKeyId(const std::string &encryptedPriKey,
+                           const std::string &password,
+                           const std::string &address,
+                           const std::vector<unsigned char> &salt, int n,
+                           SignatureScheme scheme)
+  {
+    Sha256Context ctx;
+    ctx.update(idSalt, sizeof(idSalt));
+    hashField(ctx, "private");
+    hashField(ctx, encryptedPriKey);
+    hashField(ctx, password);
+    hashField(ctx, address);
+    hashField(ctx, salt.data(), salt.size());
+    hashField(ctx, std::to_string(n));
+    hashField(ctx, std::to_string(SignatureSchemeMethod::ordinal(scheme)));
+    Digest::Hash256 id = ctx.final();
+    return std::string(id.begin(), id.end());
+  }
+
+  // caller holds mutex
+  void erase(std::list<Entry>::iterator it)
+  {
+    if (!it->secret.empty())
+    {
+      OPENSSL_cleanse(it->secret.data(), it->secret.size());
+    }
+    index.erase(it->id);
+    entries.erase(it);
+  }
+
+  // caller holds mutex
+  void eraseExpired(Clock::time_point now)
+  {
+    std::list<Entry>::iterator it = entries.begin();
+    while (it != entries.end())
+    {
+      std::list<Entry>::iterator next = it;
+      ++next;
+      if (it->expires <= now)
+      {
+        erase(it);
+      }
+      it = next;
+    }
+  }
+
+  bool lookup(const std::string &id, std::vector<unsigned char> &secret)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<std::string, std::list<Entry>::iterator>::iterator it =
+        index.find(id);
+    if (it == index.end())
+    {
+      return false;
+    }
+    if (it->second->expires <= Clock::now())
+    {
+      erase(it->second);
+      return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    secret = it->second->secret;
+    return true;
+  }
+
+  void store(const std::string &id, const std::string &address,
+             const std::vector<unsigned char> &secret)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    Clock::time_point now = Clock::now();
+    eraseExpired(now);
+    std::unordered_map<std::string, std::list<Entry>::iterator>::iterator it =
+        index.find(id);
+    if (it != index.end())
+    {
+      erase(it->second);
+    }
+    Entry entry;
+    entry.id = id;
+    entry.address = address;
+    entry.secret = secret;
+    entry.expires = now + ttl;
+    entries.push_front(entry);
+    index[id] = entries.begin();
+    if (entries.size() > capacity)
+    {
+      std::list<Entry>::iterator last = entries.end();
+      erase(--last);
+    }
+  }
+
+public:
+  static const size_t DEFAULT_CAPACITY = 64;
+
+  explicit UnlockedKeyCache(
+      size_t _capacity = DEFAULT_CAPACITY,
+      std::chrono::milliseconds _ttl = std::chrono::minutes(5))
+      : capacity(_capacity == 0 ? 1 : _capacity), ttl(_ttl)
+  {
+    if (RAND_bytes(idSalt, sizeof(idSalt)) != 1)
+    {
+      throw std::runtime_error("RAND_bytes() fail.");
+    }
+  }
+
+  UnlockedKeyCache(const UnlockedKeyCache &) = delete;
+  UnlockedKeyCache &operator=(const UnlockedKeyCache &) = delete;
+
+  ~UnlockedKeyCache()
+  {
+    clear();
+    OPENSSL_cleanse(idSalt, sizeof(idSalt));
+  }
+
+  // ScryptHandler::scrypt(password, salt, n, 8, 8, 64), the derivation
+  // behind the GCM encrypted keys, computed once per ttl
+  std::vector<unsigned char>
+  getDerivedKey(const std::string &password,
+                const std::vector<unsigned char> &salt, int n)
+  {
+    std::string id = derivedKeyId(password, salt, n);
+    std::vector<unsigned char> derivedkey;
+    if (lookup(id, derivedkey))
+    {
+      return derivedkey;
+    }
+    // concurrent misses on the same key each derive it, the last one
+    // stored wins
+    derivedkey = ScryptHandler::scrypt(password, salt, n, 8, 8, 64);
+    store(id, "", derivedkey);
+    return derivedkey;
+  }
+
+  // Account::getGcmDecodedPrivateKey, answered from the cache while the
+  // account stays unlocked
+  std::string getPrivateKey(const std::string &encryptedPriKey,
+                            const std::string &password,
+                            const std::string &address,
+                            const std::vector<unsigned char> &salt, int n,
+                            SignatureScheme scheme)
+  {
+    std::string id =
+        privateKeyId(encryptedPriKey, password, address, salt, n, scheme);
+    std::vector<unsigned char> prikey;
+    if (!lookup(id, prikey))
+    {
+      if (encryptedPriKey.empty())
+      {
+        throw new SDKException(ErrorCode::EncryptedPriKeyError);
+      }
+      if (salt.size() != 16)
+      {
+        throw new SDKException(ErrorCode::ParamError);
+      }
+      std::vector<unsigned char> derivedkey = getDerivedKey(password, salt, n);
+      std::string hex = Account::getGcmDecodedPrivateKey(
+          encryptedPriKey, address, derivedkey, scheme);
+      OPENSSL_cleanse(derivedkey.data(), derivedkey.size());
+      prikey.assign(hex.begin(), hex.end());
+      OPENSSL_cleanse(&hex[0], hex.size());
+      store(id, address, prikey);
+    }
+    std::string hex(prikey.begin(), prikey.end());
+    OPENSSL_cleanse(prikey.data(), prikey.size());
+    return hex;
+  }
+
+  // forgets the private keys cached for address; its derived keys may be
+  // shared with other accounts and stay until they expire
+  void lock(const std::string &address)
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    std::list<Entry>::iterator it = entries.begin();
+    while (it != entries.end())
+    {
+      std::list<Entry>::iterator next = it;
+      ++next;
+      if (it->address == address)
+      {
+        erase(it);
+      }
+      it = next;
+    }
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!entries.empty())
+    {
+      erase(entries.begin());
+    }
+  }
+
+  // live entries, expired ones are dropped first
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    eraseExpired(Clock::now());
+    return entries.size();
+  }
+};
+#endif // !SDK_MANAGER_UNLOCKEDKEYCACHE_H
@@ -5,26 +5,56 @@
 #error "use --std=c++11 option for compile."
 #endif
 
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../wallet/Wallet.h"
+#include "UnlockedKeyCache.h"
 
 class WalletMgr
 {
 private:
   Wallet wallet;
-  std::unordered_map<int, int> acctPriKeyMap;
+  // decrypted keys of unlocked accounts, see getAccountPrivateKey; copies
+  // of a WalletMgr share it
+  std::shared_ptr<UnlockedKeyCache> acctPriKeyMap;
   std::unordered_map<int, int> identityPriKeyMap;
   Wallet walletFile;
   // SignatureScheme scheme;
   std::string filePath;
 
 public:
-  WalletMgr()
+  WalletMgr() : acctPriKeyMap(std::make_shared<UnlockedKeyCache>())
   {
     // acctPriKeyMap = new HashMap();
     // identityPriKeyMap = new HashMap();
     filePath = "";
   }
+
+  // the hex private key behind a GCM encrypted wallet key. The first call
+  // for an account runs scrypt, later ones within the cache ttl do not.
+  std::string getAccountPrivateKey(const std::string &encryptedPriKey,
+                                   const std::string &password,
+                                   const std::string &address,
+                                   const std::vector<unsigned char> &salt,
+                                   int n, SignatureScheme scheme)
+  {
+    return acctPriKeyMap->getPrivateKey(encryptedPriKey, password, address,
+                                        salt, n, scheme);
+  }
+
+  // drops the cached private keys of address. The scrypt keys they were
+  // decrypted with stay cached until they expire, other accounts may share
+  // them; lockAllAccounts drops those too.
+  void lockAccount(const std::string &address)
+  {
+    acctPriKeyMap->lock(address);
+  }
+
+  void lockAllAccounts() { acctPriKeyMap->clear(); }
+
+  UnlockedKeyCache &getUnlockedKeys() { return *acctPriKeyMap; }
 };
 #endif // !WALLETMGR_H
\ No newline at end of file
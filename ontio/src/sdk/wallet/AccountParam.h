@@ -61,8 +61,7 @@ public:
 
   std::vector<unsigned char> getSalt()
   {
-    std::string str_salt = Helper::base64Decode(salt, false);
-    return std::vector<unsigned char>(str_salt.begin(), str_salt.end());
+    return Helper::base64DecodeBytes(salt, false);
   }
   void setSalt(const std::vector<unsigned char> &vec_salt) { salt = Helper::base64Encode(vec_salt, false); }
 
@@ -41,8 +41,7 @@ class Control
     }
     std::vector<unsigned char> getSalt()
     {
-        std::string raw_salt = Helper::base64Decode(salt, false);
-        return std::vector<unsigned char>(raw_salt.begin(), raw_salt.end());;
+        return Helper::base64DecodeBytes(salt, false);
     }
 
     void setAddress(const std::string &addr) { address = addr; }
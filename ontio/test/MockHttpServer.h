@@ -0,0 +1,199 @@
+#ifndef TEST_MOCKHTTPSERVER_H
+#define TEST_MOCKHTTPSERVER_H
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// A keep-alive HTTP/1.1 server on 127.0.0.1 for tests and benchmarks that
+// need a node without the network. Every request is answered 200 with
+// whatever handler returns for (method, path, body). One thread per
+// connection; it counts connections so tests can check they are reused.
+class MockHttpServer
+{
+public:
+  typedef std::function<std::string(const std::string &method,
+                                    const std::string &path,
+                                    const std::string &body)>
+      Handler;
+
+private:
+  Handler handler;
+  int listenFd;
+  int port;
+  std::atomic<bool> stopping;
+  std::atomic<size_t> connectionCount;
+  std::atomic<size_t> requestCount;
+  std::mutex mutex;
+  std::vector<int> clientFds;
+  std::vector<std::thread> threads;
+  std::thread acceptor;
+
+  static bool sendAll(int fd, const std::string &data)
+  {
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+      ssize_t n = ::send(fd, data.data() + sent, data.size() - sent,
+                         MSG_NOSIGNAL);
+      if (n <= 0)
+      {
+        return false;
+      }
+      sent += (size_t)n;
+    }
+    return true;
+  }
+
+  void serve(int fd)
+  {
+    std::string buffer;
+    char chunk[16384];
+    for (;;)
+    {
+      std::string::size_type end;
+      while ((end = buffer.find("\r\n\r\n")) == std::string::npos)
+      {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+        {
+          return;
+        }
+        buffer.append(chunk, (size_t)n);
+      }
+      std::string head = buffer.substr(0, end);
+      size_t length = 0;
+      std::string::size_type at = head.find("Content-Length:");
+      if (at == std::string::npos)
+      {
+        at = head.find("content-length:");
+      }
+      if (at != std::string::npos)
+      {
+        length = (size_t)strtoul(head.c_str() + at + 15, NULL, 10);
+      }
+      while (buffer.size() < end + 4 + length)
+      {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+        {
+          return;
+        }
+        buffer.append(chunk, (size_t)n);
+      }
+      std::string::size_type sp1 = head.find(' ');
+      std::string::size_type sp2 = head.find(' ', sp1 + 1);
+      std::string method = head.substr(0, sp1);
+      std::string path = head.substr(sp1 + 1, sp2 - sp1 - 1);
+      std::string body = buffer.substr(end + 4, length);
+      buffer.erase(0, end + 4 + length);
+      requestCount++;
+      std::string reply = handler(method, path, body);
+      std::string response =
+          "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+          "Content-Length: " +
+          std::to_string(reply.size()) + "\r\n\r\n" + reply;
+      if (!sendAll(fd, response))
+      {
+        return;
+      }
+    }
+  }
+
+  void acceptLoop()
+  {
+    for (;;)
+    {
+      int fd = ::accept(listenFd, NULL, NULL);
+      if (fd < 0)
+      {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stopping)
+      {
+        ::close(fd);
+        return;
+      }
+      connectionCount++;
+      clientFds.push_back(fd);
+      threads.push_back(std::thread(&MockHttpServer::serve, this, fd));
+    }
+  }
+
+public:
+  explicit MockHttpServer(const Handler &_handler)
+      : handler(_handler), listenFd(-1), port(0), stopping(false),
+        connectionCount(0), requestCount(0)
+  {
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (listenFd < 0 ||
+        ::bind(listenFd, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+        ::listen(listenFd, 128) != 0 ||
+        ::getsockname(listenFd, (sockaddr *)&addr, &len) != 0)
+    {
+      if (listenFd >= 0)
+      {
+        ::close(listenFd);
+      }
+      throw std::runtime_error("MockHttpServer: cannot listen");
+    }
+    port = ntohs(addr.sin_port);
+    acceptor = std::thread(&MockHttpServer::acceptLoop, this);
+  }
+
+  MockHttpServer(const MockHttpServer &) = delete;
+  MockHttpServer &operator=(const MockHttpServer &) = delete;
+
+  ~MockHttpServer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+      for (size_t i = 0; i < clientFds.size(); i++)
+      {
+        ::shutdown(clientFds[i], SHUT_RDWR);
+      }
+    }
+    ::shutdown(listenFd, SHUT_RDWR);
+    acceptor.join();
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+      threads[i].join();
+    }
+    for (size_t i = 0; i < clientFds.size(); i++)
+    {
+      ::close(clientFds[i]);
+    }
+    ::close(listenFd);
+  }
+
+  // http://127.0.0.1:port
+  std::string url() const
+  {
+    return "http://127.0.0.1:" + std::to_string(port);
+  }
+
+  size_t connections() const { return connectionCount; }
+
+  size_t requests() const { return requestCount; }
+};
+
+#endif
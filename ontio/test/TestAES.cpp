@@ -52,6 +52,67 @@ TEST(AES, gcmEncrypt)
   std::cout << Helper::toHexString(tag) << std::endl;
 }
 
+TEST(AES, AesGcmTest)
+{
+  // McGrew and Viega, GCM test case 16
+  std::vector<unsigned char> key = Helper::hexStringToByte(
+      "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308");
+  std::vector<unsigned char> iv =
+      Helper::hexStringToByte("cafebabefacedbaddecaf888");
+  std::vector<unsigned char> plaintext = Helper::hexStringToByte(
+      "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+      "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39");
+  std::vector<unsigned char> aad =
+      Helper::hexStringToByte("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+  std::string sealed =
+      "0x522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+      "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662"
+      "76fc6ece0f4e1768cddf8853bb2d551b";
+
+  AesGcm gcm(key);
+  EXPECT_EQ(sealed, Helper::toHexString(gcm.encrypt(plaintext, iv, aad)));
+  // the context is reused for the next message
+  EXPECT_EQ(sealed, Helper::toHexString(gcm.encrypt(plaintext, iv, aad)));
+  EXPECT_EQ(plaintext, gcm.decrypt(Helper::hexStringToByte(sealed), iv, aad));
+  EXPECT_EQ(sealed, Helper::toHexString(
+                        AES::gcmEncrypt(plaintext, key, iv, false, aad)));
+
+  std::vector<unsigned char> tampered = Helper::hexStringToByte(sealed);
+  tampered[3] ^= 1;
+  EXPECT_THROW(gcm.decrypt(tampered, iv, aad), std::runtime_error);
+  EXPECT_THROW(gcm.decrypt(Helper::hexStringToByte(sealed), iv),
+               std::runtime_error);
+  EXPECT_THROW(AesGcm(std::vector<unsigned char>(16)), std::runtime_error);
+}
+
+TEST(AES, BatchTest)
+{
+  std::vector<std::vector<unsigned char>> plaintexts, keys, ivs, aads;
+  for (int i = 0; i < 10; i++)
+  {
+    plaintexts.push_back(std::vector<unsigned char>(32, (unsigned char)i));
+    // runs of equal keys, the batch only rekeys between them
+    keys.push_back(std::vector<unsigned char>(32, (unsigned char)(i / 3)));
+    ivs.push_back(std::vector<unsigned char>(12, (unsigned char)(i * 7)));
+    aads.push_back(std::vector<unsigned char>(i, 'a'));
+  }
+  std::vector<std::vector<unsigned char>> sealed =
+      AES::gcmEncryptBatch(plaintexts, keys, ivs, aads);
+  ASSERT_EQ(plaintexts.size(), sealed.size());
+  for (size_t i = 0; i < sealed.size(); i++)
+  {
+    EXPECT_EQ(AES::gcmEncrypt(plaintexts[i], keys[i], ivs[i], false, aads[i]),
+              sealed[i]);
+  }
+  EXPECT_EQ(plaintexts, AES::gcmDecryptBatch(sealed, keys, ivs, aads));
+  sealed[5].back() ^= 1;
+  EXPECT_THROW(AES::gcmDecryptBatch(sealed, keys, ivs, aads),
+               std::runtime_error);
+  keys.pop_back();
+  EXPECT_THROW(AES::gcmEncryptBatch(plaintexts, keys, ivs),
+               std::runtime_error);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,228 @@
+#include "../src/account/Account.h"
+#include "../src/account/AccountGenerator.h"
+#include "../src/crypto/CurveRegistry.h"
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+static const std::string private_key =
+    "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de";
+
+TEST(Account, PublicKeyTest)
+{
+  Account account(private_key);
+  EXPECT_EQ("032CF2191A24C6BEE28ABBEE0C4B5265DC841394F2794C1FB18E52FFB2C9D7C9C6",
+            account.serializePublicKey_str());
+  EXPECT_EQ(account.serializePublicKey_str(),
+            Signature::EC_get_pubkey_by_prikey(private_key, CurveName::p256));
+}
+
+TEST(Account, SignTest)
+{
+  Account account(private_key);
+  Account copy;
+  copy = account;
+  std::vector<unsigned char> msg =
+      Digest::hash256(Digest::sha256(Helper::hexStringToByte("00d1e803")));
+  SignatureHandler handler(KeyType::ECDSA, SignatureScheme::SHA256withECDSA,
+                           CurveName::p256);
+  for (int i = 0; i < 16; i++)
+  {
+    std::vector<unsigned char> sig =
+        (i % 2 == 0 ? account : copy).generateSignature(msg);
+    ASSERT_EQ(65u, sig.size());
+    EXPECT_EQ((unsigned char)SignatureScheme::SHA256withECDSA, sig[0]);
+    std::vector<unsigned char> rs(sig.begin() + 1, sig.end());
+    EXPECT_TRUE(handler.verifySignature(account.serializePublicKey_str(),
+                                        msg, rs));
+  }
+}
+
+TEST(Account, FixedLengthTest)
+{
+  // r or s starts with a zero byte in about one of 128 signatures, they
+  // must still come out as 32 bytes each
+  Account account(private_key);
+  ECKey key = ECKey::fromPublicKeyHex(account.serializePublicKey_str(),
+                                      CurveName::p256);
+  std::vector<unsigned char> msg(32, 0x5a);
+  for (int i = 0; i < 1024; i++)
+  {
+    std::vector<unsigned char> sig = account.generateSignature(msg);
+    ASSERT_EQ(65u, sig.size());
+    std::vector<unsigned char> rs(sig.begin() + 1, sig.end());
+    ASSERT_TRUE(SignatureHandler::ECDSA_verify_digest(key, msg, rs));
+  }
+}
+
+TEST(Account, HashedMessageTest)
+{
+  std::vector<unsigned char> msg = Helper::hexStringToByte("00d1e803");
+  SignatureHandler handler(KeyType::ECDSA, SignatureScheme::SHA256withECDSA,
+                           CurveName::p256);
+  std::vector<unsigned char> rs =
+      handler.generateSignature(private_key, msg, CurveName::p256, "");
+  ASSERT_EQ(64u, rs.size());
+  Account account(private_key);
+  EXPECT_TRUE(handler.verifySignature(account.serializePublicKey_str(),
+                                      Digest::sha256(msg), rs));
+}
+
+TEST(Account, Ed25519Test)
+{
+  // RFC 8032 section 7.1, test 2
+  std::string seed =
+      "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb";
+  std::vector<unsigned char> msg(1, 0x72);
+  Account account(seed, SignatureScheme::SHA512withEDDSA, CurveName::ED25519);
+  EXPECT_EQ(CurveName::ED25519, account.getCurveName());
+  EXPECT_EQ("1419"
+            "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+            account.serializePublicKey_str());
+
+  std::vector<unsigned char> sig = account.generateSignature(msg);
+  EXPECT_EQ("0x0a"
+            "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+            "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00",
+            Helper::toHexString(sig));
+  std::vector<Signature> sigs;
+  sigs.push_back(Signature(sig));
+  EXPECT_TRUE(account.verifySignature(msg, sigs));
+  msg[0] ^= 1;
+  EXPECT_FALSE(account.verifySignature(msg, sigs));
+
+  // serialized key || OP_CHECKSIG, hashed like any other public key
+  std::vector<unsigned char> pub_key = account.serializePublicKey();
+  std::vector<unsigned char> program =
+      Program::ProgramFromPubKey(std::string(pub_key.begin(), pub_key.end()));
+  EXPECT_EQ(Digest::hash160(program), account.getAddressU160().toArray());
+
+  Account from_public(false, pub_key);
+  EXPECT_EQ(account.serializePublicKey_str(),
+            from_public.serializePublicKey_str());
+}
+
+TEST(Account, CreateTest)
+{
+  const SignatureScheme schemes[] = {SignatureScheme::SHA256withECDSA,
+                                     SignatureScheme::SHA512withEDDSA};
+  for (size_t i = 0; i < 2; i++)
+  {
+    Account account = Account::create(schemes[i]);
+    Account other = Account::create(schemes[i]);
+    EXPECT_NE(account.serializePublicKey_str(), other.serializePublicKey_str());
+    std::vector<unsigned char> msg(32, (unsigned char)i);
+    std::vector<Signature> sigs;
+    sigs.push_back(Signature(account.generateSignature(msg)));
+    EXPECT_TRUE(account.verifySignature(msg, sigs));
+    EXPECT_FALSE(other.verifySignature(msg, sigs));
+  }
+  ECKey key = ECKey::generate(CurveName::p256);
+  EXPECT_EQ(64u, key.getPrivateKeyHex().size());
+  EXPECT_EQ(key.getPublicKeyHex(),
+            ECKey(key.getPrivateKeyHex(), CurveName::p256).getPublicKeyHex());
+}
+
+TEST(Account, CurveRegistryTest)
+{
+  const EC_GROUP *group = CurveRegistry::group(CurveName::p256);
+  ASSERT_TRUE(group != NULL);
+  EXPECT_EQ(group, CurveRegistry::group(CurveName::p256));
+  EXPECT_EQ(NID_X9_62_prime256v1, EC_GROUP_get_curve_name(group));
+  EXPECT_NE(group, CurveRegistry::group(CurveName::SM2P256V1));
+  EXPECT_ANY_THROW(CurveRegistry::group(CurveName::ED25519));
+
+  // keys made on the shared group sign and verify like any other
+  ECKey key = ECKey::generate(CurveName::p384);
+  EXPECT_EQ(EC_GROUP_get_curve_name(CurveRegistry::group(CurveName::p384)),
+            EC_GROUP_get_curve_name(EC_KEY_get0_group(key.get())));
+  std::vector<unsigned char> digest(48, 0x5a);
+  std::vector<unsigned char> sig = SignatureHandler::ECDSA_sign_digest(
+      key, digest, CurveName::p384);
+  EXPECT_EQ(96u, sig.size());
+  EXPECT_TRUE(SignatureHandler::ECDSA_verify_digest(key, digest, sig));
+}
+
+TEST(Account, GcmKeystoreTest)
+{
+  Account account(private_key);
+  std::string address = account.getAddressU160().toBase58();
+  std::vector<unsigned char> salt(16, 0x2a);
+  std::string encrypted =
+      account.exportGcmEncryptedPrikey("password", salt, 1024);
+  // 32 key bytes and a 16 byte tag
+  EXPECT_EQ(48u, Helper::base64DecodeBytes(encrypted, false).size());
+  EXPECT_EQ("0x" + private_key,
+            Account::getGcmDecodedPrivateKey(encrypted, "password", address,
+                                             salt, 1024,
+                                             SignatureScheme::SHA256withECDSA));
+
+  const std::string wrong[] = {"wrong password", "password"};
+  const std::string addresses[] = {address, "AMAx993nE6NEqZjwBssUfopxnnvTdob9ij"};
+  for (size_t i = 0; i < 2; i++)
+  {
+    bool thrown = false;
+    try
+    {
+      Account::getGcmDecodedPrivateKey(encrypted, wrong[i], addresses[i], salt,
+                                       1024, SignatureScheme::SHA256withECDSA);
+    }
+    catch (SDKException *e)
+    {
+      thrown = true;
+      delete e;
+    }
+    EXPECT_TRUE(thrown);
+  }
+}
+
+TEST(Account, GenerateAccountsTest)
+{
+  const SignatureScheme schemes[] = {SignatureScheme::SHA256withECDSA,
+                                     SignatureScheme::SHA512withEDDSA};
+  for (size_t s = 0; s < 2; s++)
+  {
+    // more than one chunk per worker, and a partial last chunk
+    std::vector<GeneratedAccount> accounts =
+        AccountGenerator::generateAccounts(1000, 3, schemes[s]);
+    ASSERT_EQ(1000u, accounts.size());
+    std::set<std::string> addresses;
+    for (size_t i = 0; i < accounts.size(); i++)
+    {
+      addresses.insert(accounts[i].address);
+    }
+    EXPECT_EQ(accounts.size(), addresses.size());
+    for (size_t i = 0; i < accounts.size(); i += 97)
+    {
+      Account account(accounts[i].privateKey, schemes[s]);
+      EXPECT_EQ(account.serializePublicKey_str(), accounts[i].publicKey);
+      EXPECT_EQ(account.getAddressU160().toBase58(), accounts[i].address);
+    }
+  }
+
+  size_t seen = 0;
+  EXPECT_THROW(AccountGenerator::generateAccounts(
+                   5000, 2,
+                   [&seen](const GeneratedAccount &) {
+                     if (++seen == 300)
+                     {
+                       throw std::runtime_error("sink full");
+                     }
+                   }),
+               std::runtime_error);
+  EXPECT_LT(seen, 5000u);
+  EXPECT_TRUE(AccountGenerator::generateAccounts(0, 2).empty());
+  EXPECT_THROW(AccountGenerator::generateAccounts(
+                   1, 1, SignatureScheme::SM3withSM2),
+               std::runtime_error);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+
+#include "../src/common/Address.h"
+#include "../src/core/program/Program.h"
+#include "../src/crypto/ECKey.h"
+#include "../src/crypto/PublicKeyCache.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(Address, Base58Test)
+{
+  std::string base58 = "AFsB96x5C9MUyw1QMoTAKP3xrWLr6vqZSX";
+  Address address = Address::decodeBase58(base58);
+  EXPECT_EQ("0x0100aeb10ff2919bfe14dc432899d3b649893119",
+            Helper::toHexString(address.toArray()));
+  EXPECT_EQ(base58, address.toBase58());
+
+  std::string bad_checksum = base58;
+  bad_checksum[base58.size() - 1] = 'Y';
+  EXPECT_ANY_THROW(Address::decodeBase58(bad_checksum));
+  EXPECT_ANY_THROW(Address::decodeBase58("2g"));
+  EXPECT_ANY_THROW(Address::decodeBase58(base58 + "1"));
+}
+
+TEST(Address, BatchTest)
+{
+  std::vector<Address> addresses;
+  for (int i = 0; i < 100; i++)
+  {
+    std::vector<unsigned char> value(20);
+    for (size_t j = 0; j < value.size(); j++)
+    {
+      value[j] = (unsigned char)(i * 31 + j * 7);
+    }
+    if (i % 10 == 0)
+    {
+      value[0] = 0;
+    }
+    addresses.push_back(Address(value));
+  }
+  std::vector<std::string> encoded = Address::toBase58(addresses);
+  ASSERT_EQ(addresses.size(), encoded.size());
+  std::vector<Address> decoded = Address::decodeBase58(encoded);
+  ASSERT_EQ(addresses.size(), decoded.size());
+  for (size_t i = 0; i < addresses.size(); i++)
+  {
+    std::vector<unsigned char> data;
+    data.push_back(0x17);
+    std::vector<unsigned char> value = addresses[i].bytes();
+    data.insert(data.end(), value.begin(), value.end());
+    std::vector<unsigned char> checksum =
+        Digest::sha256(Digest::sha256(data));
+    data.insert(data.end(), checksum.begin(), checksum.begin() + 4);
+    EXPECT_EQ(Helper::EncodeBase58(data), encoded[i]);
+    EXPECT_TRUE(decoded[i].equals(addresses[i]));
+  }
+}
+
+TEST(Address, MultiPubKeyTest)
+{
+  std::vector<std::string> public_keys;
+  for (int i = 1; i <= 16; i++)
+  {
+    std::string private_key(64, '0');
+    private_key[62] = "0123456789abcdef"[i / 16];
+    private_key[63] = "0123456789abcdef"[i % 16];
+    public_keys.push_back(
+        ECKey(private_key, CurveName::p256).getPublicKeyHex());
+  }
+  std::vector<std::string> sorted = public_keys;
+  Program::sortPublicKeys(sorted);
+  for (size_t i = 1; i < sorted.size(); i++)
+  {
+    DecodedPublicKey prev = PublicKeyCache::decode(sorted[i - 1]);
+    DecodedPublicKey next = PublicKeyCache::decode(sorted[i]);
+    EXPECT_EQ(0x12, next.label);
+    EXPECT_EQ(32u, next.x.size());
+    // ordered by x, not by the 02 / 03 prefix of the hex string
+    EXPECT_TRUE(prev.x < next.x);
+  }
+  EXPECT_GE(PublicKeyCache::shared().size(), public_keys.size());
+
+  std::string address =
+      Address::addressFromMultiPubKeys(5, public_keys).toBase58();
+  std::reverse(public_keys.begin(), public_keys.end());
+  EXPECT_EQ(address, Address::addressFromMultiPubKeys(5, public_keys).toBase58());
+
+  // the same point compressed or not decodes to the same coordinates
+  ECKey key("0000000000000000000000000000000000000000000000000000000000000007",
+            CurveName::p256);
+  EXPECT_EQ(0, PublicKeyCache::decode(key.getPublicKeyHex())
+                   .compare(PublicKeyCache::decode(
+                       key.getPublicKeyHex(POINT_CONVERSION_UNCOMPRESSED))));
+  EXPECT_ANY_THROW(PublicKeyCache::decode("02zz"));
+  EXPECT_ANY_THROW(PublicKeyCache::decode("0300"));
+}
+
+TEST(Address, PublicKeyCacheTest)
+{
+  PublicKeyCache cache(2);
+  std::string keys[3];
+  for (int i = 0; i < 3; i++)
+  {
+    std::string private_key(64, '0');
+    private_key[63] = (char)('a' + i);
+    keys[i] = ECKey(private_key, CurveName::p256).getPublicKeyHex();
+  }
+  cache.get(keys[0]);
+  cache.get(keys[1]);
+  cache.get(keys[0]);
+  // keys[1] is the least recently used and makes room for keys[2]
+  cache.get(keys[2]);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(0, cache.get(keys[0]).compare(PublicKeyCache::decode(keys[0])));
+  EXPECT_EQ(0, cache.get(keys[2]).compare(PublicKeyCache::decode(keys[2])));
+  EXPECT_EQ(2u, cache.size());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
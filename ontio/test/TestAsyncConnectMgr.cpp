@@ -0,0 +1,200 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/sdk/manager/AsyncConnectMgr.h"
+#include "MockHttpServer.h"
+
+// answers getblockcount with 4242, getblock with the requested height,
+// getstorage with its key and anything else with an error
+static std::string node(const std::string &, const std::string &,
+                        const std::string &body)
+{
+  nlohmann::json call = nlohmann::json::parse(body);
+  nlohmann::json response = {
+      {"jsonrpc", "2.0"}, {"id", call["id"]}, {"error", 0}};
+  std::string method = call["method"];
+  if (method == "getblockcount")
+  {
+    response["result"] = 4242;
+  }
+  else if (method == "getblock")
+  {
+    response["result"] = {{"Height", call["params"][0]}};
+  }
+  else if (method == "getstorage")
+  {
+    response["result"] = call["params"][1];
+  }
+  else
+  {
+    response["error"] = 42001;
+    response["result"] = "";
+  }
+  return response.dump();
+}
+
+TEST(AsyncConnectMgr, FutureTest)
+{
+  MockHttpServer server(node);
+  std::shared_ptr<CurlMultiLoop> loop =
+      std::make_shared<CurlMultiLoop>(10000, 4);
+  AsyncConnectMgr connect_mgr(server.url(), loop);
+
+  // hundreds in flight from this one thread
+  std::vector<std::future<nlohmann::json>> blocks;
+  for (int h = 0; h < 300; h++)
+  {
+    blocks.push_back(connect_mgr.getBlockJson(h));
+  }
+  std::future<int> height = connect_mgr.getBlockHeight();
+  std::future<std::string> storage = connect_mgr.getStorage("ff00", "0a0b");
+  for (int h = 0; h < 300; h++)
+  {
+    EXPECT_EQ(h, blocks[h].get()["Height"].get<int>());
+  }
+  EXPECT_EQ(4242, height.get());
+  EXPECT_EQ("0a0b", storage.get());
+  EXPECT_EQ(302u, server.requests());
+  EXPECT_LE(server.connections(), 4u);
+  EXPECT_EQ(0u, loop->inFlight());
+
+  EXPECT_FALSE(connect_mgr.sendRawTransaction("0x00d1").get());
+  std::future<std::string> version = connect_mgr.getVersion();
+  EXPECT_THROW(version.get(), std::runtime_error);
+}
+
+TEST(AsyncConnectMgr, CallbackTest)
+{
+  MockHttpServer server(node);
+  AsyncConnectMgr connect_mgr(server.url());
+  std::promise<void> done;
+  std::atomic<int> sum(0);
+  std::atomic<int> left(100);
+  for (int h = 0; h < 100; h++)
+  {
+    connect_mgr.getBlockJson(
+        h, [&](std::exception_ptr error, const nlohmann::json &block) {
+          EXPECT_FALSE(error);
+          sum += block["Height"].get<int>();
+          if (--left == 0)
+          {
+            done.set_value();
+          }
+        });
+  }
+  done.get_future().get();
+  EXPECT_EQ(99 * 100 / 2, sum.load());
+}
+
+TEST(AsyncConnectMgr, ErrorTest)
+{
+  std::string url;
+  {
+    MockHttpServer server(node);
+    url = server.url();
+  }
+  AsyncConnectMgr refused(url);
+  std::future<int> height = refused.getBlockHeight();
+  EXPECT_THROW(height.get(), std::runtime_error);
+
+  MockHttpServer slow(
+      [](const std::string &m, const std::string &p, const std::string &b) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        return node(m, p, b);
+      });
+  AsyncConnectMgr timed_out(slow.url(),
+                            std::make_shared<CurlMultiLoop>(100));
+  height = timed_out.getBlockHeight();
+  EXPECT_THROW(height.get(), std::runtime_error);
+
+  std::future<int> pending;
+  {
+    std::shared_ptr<CurlMultiLoop> loop = std::make_shared<CurlMultiLoop>();
+    pending = AsyncConnectMgr(slow.url(), loop).getBlockHeight();
+  }
+  // the loop went away with the request in flight
+  EXPECT_THROW(pending.get(), std::runtime_error);
+}
+
+TEST(AsyncConnectMgr, StopTest)
+{
+  MockHttpServer slow(
+      [](const std::string &m, const std::string &p, const std::string &b) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        return node(m, p, b);
+      });
+  std::vector<std::future<int>> futures;
+  std::atomic<size_t> stopped(0);
+  std::mutex mutex;
+  std::set<size_t> left;
+  {
+    // one connection: the first request is on the wire, the rest queue
+    std::shared_ptr<CurlMultiLoop> loop =
+        std::make_shared<CurlMultiLoop>(60000, 1);
+    CurlMultiLoop *raw = loop.get();
+    AsyncConnectMgr async(slow.url(), loop);
+    futures.push_back(async.getBlockHeight());
+    while (slow.requests() == 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (size_t i = 0; i < 32; i++)
+    {
+      futures.push_back(async.getBlockHeight());
+      async.getBlockHeight([&stopped, &mutex, &left,
+                            raw](std::exception_ptr error, const int &) {
+        try
+        {
+          std::rethrow_exception(error);
+        }
+        catch (const std::runtime_error &e)
+        {
+          if (std::string(e.what()) == "CurlMultiLoop stopped")
+          {
+            stopped++;
+          }
+        }
+        catch (...)
+        {
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        left.insert(raw->inFlight());
+      });
+    }
+  }
+  // every request was failed and none dropped; each is uncounted before
+  // its callback runs, so every callback saw fewer in flight than the last
+  EXPECT_EQ(32u, stopped.load());
+  EXPECT_EQ(32u, left.size());
+  EXPECT_GT(futures.size() + 32, *left.rbegin());
+  for (size_t i = 0; i < futures.size(); i++)
+  {
+    ASSERT_EQ(std::future_status::ready,
+              futures[i].wait_for(std::chrono::seconds(0)));
+    try
+    {
+      futures[i].get();
+      ADD_FAILURE() << "request " << i << " was not stopped";
+    }
+    catch (const std::runtime_error &e)
+    {
+      EXPECT_STREQ("CurlMultiLoop stopped", e.what());
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
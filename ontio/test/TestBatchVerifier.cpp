@@ -0,0 +1,117 @@
+#include "../src/account/Account.h"
+#include "../src/crypto/BatchVerifier.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+static const char *private_keys[] = {
+    "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de",
+    "49855b16636e70f100cc5f4f42bc20a6535d7414fb8845e7310f8dd065a97221",
+    "1094e90dd7c4fdfd849c14798d725ac351ae0d924b29a279a9ffa77d5737bd96"};
+
+// scheme byte || r || s
+static std::vector<unsigned char> sign(Account &account,
+                                       const std::vector<unsigned char> &msg)
+{
+  return account.generateSignature(msg);
+}
+
+static std::vector<VerifyItem> makeItems(size_t count)
+{
+  std::vector<VerifyItem> items(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    Account account(private_keys[i % 3]);
+    std::vector<unsigned char> data(1, (unsigned char)i);
+    items[i].publicKey =
+        Helper::hexStringToByte(account.serializePublicKey_str());
+    items[i].digest = Digest::hash256(Digest::sha256(data));
+    items[i].signature = sign(account, items[i].digest);
+  }
+  return items;
+}
+
+TEST(BatchVerifier, VerifyTest)
+{
+  std::vector<VerifyItem> items = makeItems(30);
+  // r || s without the scheme byte is accepted too
+  items[1].signature.erase(items[1].signature.begin());
+  items[4].digest[0] ^= 1;
+  items[7].signature[10] ^= 1;
+  items[9].publicKey = items[10].publicKey;
+  items[12].publicKey.resize(10);
+
+  BatchVerifier verifier(4);
+  std::vector<bool> result = verifier.verify(items);
+  ASSERT_EQ(items.size(), result.size());
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    bool expected = i != 4 && i != 7 && i != 9 && i != 12;
+    EXPECT_EQ(expected, result[i]) << i;
+    EXPECT_EQ(expected, verifier.verify(items[i])) << i;
+  }
+  EXPECT_EQ(4u, verifier.cachedKeys());
+  EXPECT_TRUE(verifier.verify(std::vector<VerifyItem>()).empty());
+}
+
+TEST(BatchVerifier, Ed25519Test)
+{
+  std::vector<VerifyItem> items = makeItems(4);
+  Account account = Account::create(SignatureScheme::SHA512withEDDSA);
+  for (size_t i = 0; i < 4; i++)
+  {
+    VerifyItem item;
+    item.publicKey = account.serializePublicKey();
+    item.digest = std::vector<unsigned char>(32, (unsigned char)i);
+    item.signature = account.generateSignature(item.digest);
+    items.push_back(item);
+  }
+  items[5].digest[0] ^= 1;
+  BatchVerifier verifier(2);
+  std::vector<bool> result = verifier.verify(items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    EXPECT_EQ(i != 5, result[i]) << i;
+  }
+}
+
+TEST(BatchVerifier, MatchesSignatureHandlerTest)
+{
+  std::vector<VerifyItem> items = makeItems(6);
+  items[2].digest[31] ^= 0x80;
+  SignatureHandler handler(KeyType::ECDSA, SignatureScheme::SHA256withECDSA,
+                           CurveName::p256);
+  BatchVerifier verifier(2);
+  std::vector<bool> result = verifier.verify(items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    std::vector<unsigned char> rs(items[i].signature.begin() + 1,
+                                  items[i].signature.end());
+    std::string public_key = Helper::toHexString(items[i].publicKey).substr(2);
+    EXPECT_EQ(handler.verifySignature(public_key, items[i].digest, rs),
+              result[i]);
+  }
+}
+
+TEST(BatchVerifier, AccountVerifyTest)
+{
+  Account account(private_keys[0]);
+  Account other(private_keys[1]);
+  std::vector<unsigned char> msg = Digest::hash256(Digest::sha256(
+      std::vector<unsigned char>(1, 0x42)));
+  std::vector<Signature> sigs;
+  sigs.push_back(Signature(sign(account, msg)));
+  EXPECT_TRUE(account.verifySignature(msg, sigs));
+  EXPECT_FALSE(other.verifySignature(msg, sigs));
+  sigs.push_back(Signature(sign(other, msg)));
+  EXPECT_FALSE(account.verifySignature(msg, sigs));
+  EXPECT_FALSE(account.verifySignature(msg, std::vector<Signature>()));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
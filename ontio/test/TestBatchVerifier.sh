@@ -0,0 +1,10 @@
+#!/bin/bash
+path=$(
+	cd $(dirname $0)
+	pwd
+)
+cd $path
+g++ TestBatchVerifier.cpp $(pkg-config --cflags gtest_main --libs openssl libcurl gtest_main) -std=c++11 -pthread -o ../bin/test
+../bin/test
+rm ../bin/test &&
+cd $path/../
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/common/Helper.h"
+#include "../src/core/payload/InvokeCodeTransaction.h"
+#include "../src/io/BinaryReader.h"
+
+TEST(BinaryReader, FixedWidthTest)
+{
+  std::vector<unsigned char> data{0x01, 0x34, 0x12, 0x78, 0x56, 0x34,
+                                  0x12, 0xef, 0xcd, 0xab, 0x89, 0x67,
+                                  0x45, 0x23, 0x01, 0x00};
+  BinaryReader reader(data.data(), data.size());
+  EXPECT_EQ(0x01, reader.readByte());
+  EXPECT_EQ(0x1234, reader.readUInt16());
+  EXPECT_EQ(0x12345678u, reader.readInt());
+  EXPECT_EQ(0x0123456789abcdefLL, reader.readLong());
+  EXPECT_FALSE(reader.readBool());
+  EXPECT_EQ(0u, reader.available());
+  EXPECT_THROW(reader.readByte(), std::runtime_error);
+}
+
+TEST(BinaryReader, VarIntTest)
+{
+  std::vector<unsigned char> data{0xfc, 0xfd, 0xfd, 0x00, 0xfe, 0x00, 0x00,
+                                  0x01, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00,
+                                  0x01, 0x00, 0x00, 0x00};
+  BinaryReader reader(data.data(), data.size());
+  EXPECT_EQ(0xfc, reader.readVarInt());
+  EXPECT_EQ(0xfd, reader.readVarInt());
+  EXPECT_EQ(0x10000, reader.readVarInt());
+  EXPECT_EQ(0x100000000LL, reader.readVarInt());
+  std::vector<unsigned char> short_data{0xfe, 0x00, 0x01};
+  BinaryReader short_reader(short_data.data(), short_data.size());
+  EXPECT_THROW(short_reader.readVarInt(), std::runtime_error);
+}
+
+TEST(BinaryReader, SpanTest)
+{
+  std::vector<unsigned char> data{0x03, 0xaa, 0xbb, 0xcc, 0x02, 0x68, 0x69};
+  BinaryReader reader(data.data(), data.size());
+  int len = (int)reader.readVarInt();
+  const unsigned char *span = reader.readSpan(len);
+  EXPECT_EQ(data.data() + 1, span);
+  EXPECT_EQ(std::string("hi"), reader.readVarString());
+  EXPECT_EQ(data.size(), reader.position());
+}
+
+TEST(BinaryReader, HexAdapterTest)
+{
+  std::string hex = "0134127856341203aabbcc";
+  BinaryReader reader;
+  reader.set_uc_vec(hex);
+  EXPECT_EQ(0x01, reader.readByte());
+  EXPECT_EQ(0x1234, reader.readUInt16());
+  EXPECT_EQ(0x12345678u, reader.readInt());
+  EXPECT_EQ(std::string("aabbcc"), reader.readVarBytes());
+}
+
+TEST(BinaryReader, TransactionTest)
+{
+  std::vector<unsigned char> code{0x00, 0xc6, 0x6b, 0x14, 0x26, 0x1b};
+  std::vector<unsigned char> payer_bytes(20, 0x5a);
+  Address payer(payer_bytes);
+  InvokeCodeTransaction tx(code, 500, 20000, payer);
+  std::vector<unsigned char> unsigned_tx = tx.getHashData();
+
+  BinaryReader reader(unsigned_tx.data(), unsigned_tx.size());
+  InvokeCodeTransaction parsed;
+  parsed.deserializeUnsigned(&reader);
+  EXPECT_EQ(0u, reader.available());
+  EXPECT_EQ(unsigned_tx, parsed.getHashData());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
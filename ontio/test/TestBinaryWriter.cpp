@@ -0,0 +1,88 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/account/Account.h"
+#include "../src/common/Helper.h"
+#include "../src/core/asset/Sig.h"
+#include "../src/core/asset/Transfers.h"
+#include "../src/core/payload/InvokeCodeTransaction.h"
+#include "../src/io/BinaryWriter.h"
+
+TEST(BinaryWriter, FixedWidthTest)
+{
+  BinaryWriter writer;
+  writer.writeByte(0x01);
+  writer.writeShort(0x1234);
+  writer.writeInt(0x12345678);
+  writer.writeLong(0x0123456789abcdefLL);
+  EXPECT_EQ("0x01341278563412efcdab8967452301",
+            Helper::toHexString(writer.toByteArray()));
+}
+
+TEST(BinaryWriter, VarIntTest)
+{
+  long long values[] = {0xfc, 0xfd, 0xffff, 0x10000, 0x100000000LL};
+  std::string targets[] = {"0xfc", "0xfdfd00", "0xfdffff", "0xfe00000100",
+                           "0xff0000000001000000"};
+  for (int i = 0; i < 5; i++)
+  {
+    BinaryWriter writer;
+    writer.writeVarInt(values[i]);
+    EXPECT_EQ(targets[i], Helper::toHexString(writer.toByteArray()));
+    EXPECT_EQ(writer.size(), BinaryWriter::varIntSize(values[i]));
+  }
+  BinaryWriter writer;
+  writer.writeVarString("hi");
+  EXPECT_EQ("0x026869", Helper::toHexString(writer.toByteArray()));
+}
+
+TEST(BinaryWriter, SerializedSizeTest)
+{
+  std::vector<unsigned char> from_bytes(20, 0x11);
+  std::vector<unsigned char> to_bytes(20, 0x22);
+  State state(Address(from_bytes), Address(to_bytes), 100000);
+  Transfers transfers(std::vector<State>(3, state));
+  EXPECT_EQ(transfers.toArray().size(), transfers.serializedSize());
+
+  std::vector<unsigned char> code(300, 0x51);
+  InvokeCodeTransaction tx(code, 500, 20000, Address(from_bytes));
+  EXPECT_EQ(tx.getHashData().size(), tx.serializedUnsignedSize());
+
+  Account acct(
+      "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de");
+  Sig sig(acct.serializePublicKey_str(), 1,
+          tx.sign_str(acct, SignatureScheme::SHA256withECDSA, CurveName::p256));
+  tx.add_sig(sig);
+  size_t tx_sz = tx.serializedSize();
+  EXPECT_EQ(tx.toArray().size(), tx_sz);
+
+  BinaryWriter writer(tx_sz);
+  size_t capacity = writer.capacity();
+  tx.serialize(&writer);
+  EXPECT_EQ(tx_sz, writer.size());
+  EXPECT_EQ(capacity, writer.capacity());
+}
+
+TEST(BinaryWriter, ReuseTest)
+{
+  BinaryWriter writer(64);
+  writer.writeLong(1);
+  const unsigned char *data = writer.bytes().data();
+  size_t capacity = writer.capacity();
+  writer.reset();
+  EXPECT_EQ(0u, writer.size());
+  EXPECT_EQ(capacity, writer.capacity());
+  writer.writeLong(2);
+  EXPECT_EQ(data, writer.bytes().data());
+  std::vector<unsigned char> out = std::move(writer).take();
+  EXPECT_EQ(data, out.data());
+  EXPECT_EQ(8u, out.size());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
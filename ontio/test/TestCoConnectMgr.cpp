@@ -0,0 +1,110 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/common/Coroutine.h"
+#include "../src/sdk/manager/CoConnectMgr.h"
+#include "MockHttpServer.h"
+
+// getblockcount is 4242, getblock echoes its height, sendrawtransaction
+// accepts anything but "00" and getblockheightbytxhash answers 4200
+static std::string node(const std::string &, const std::string &,
+                        const std::string &body)
+{
+  nlohmann::json call = nlohmann::json::parse(body);
+  nlohmann::json response = {
+      {"jsonrpc", "2.0"}, {"id", call["id"]}, {"error", 0}};
+  std::string method = call["method"];
+  if (method == "getblockcount")
+  {
+    response["result"] = 4242;
+  }
+  else if (method == "getblock")
+  {
+    response["result"] = {{"Height", call["params"][0]}};
+  }
+  else if (method == "sendrawtransaction")
+  {
+    response["error"] = call["params"][0] == "00" ? 43001 : 0;
+    response["result"] = "txhash";
+  }
+  else if (method == "getblockheightbytxhash")
+  {
+    response["result"] = 4200;
+  }
+  else
+  {
+    response["error"] = 42001;
+  }
+  return response.dump();
+}
+
+static Task<int> confirmations(CoConnectMgr &node, std::string tx,
+                               std::string txhash)
+{
+  if (!co_await node.sendRawTransaction(tx))
+  {
+    co_return -1;
+  }
+  int height = co_await node.getBlockHeight();
+  co_return height - co_await node.getBlockHeightByTxHash(txhash);
+}
+
+static Task<int> sumHeights(CoConnectMgr &node, int from, int to)
+{
+  int sum = 0;
+  for (int h = from; h < to; h++)
+  {
+    nlohmann::json block = co_await node.getBlockJson(h);
+    sum += block["Height"].get<int>();
+  }
+  co_return sum;
+}
+
+static Task<void> failing(CoConnectMgr &node)
+{
+  co_await node.getStorage("ff00", "0a");
+}
+
+TEST(CoConnectMgr, InlineTest)
+{
+  MockHttpServer server(node);
+  CoConnectMgr connect_mgr(server.url());
+  EXPECT_EQ(42, syncWait(confirmations(connect_mgr, "0x00d1", "aa")));
+  EXPECT_EQ(-1, syncWait(confirmations(connect_mgr, "0x00", "aa")));
+  EXPECT_EQ(99 * 100 / 2, syncWait(sumHeights(connect_mgr, 0, 100)));
+  EXPECT_THROW(syncWait(failing(connect_mgr)), std::runtime_error);
+}
+
+TEST(CoConnectMgr, ThreadPoolTest)
+{
+  MockHttpServer server(node);
+  std::shared_ptr<CurlMultiLoop> loop =
+      std::make_shared<CurlMultiLoop>(10000, 4);
+  CoConnectMgr connect_mgr(server.url(),
+                           std::make_shared<ThreadPoolExecutor>(2), loop);
+  // many pipelines in flight, none holding a thread while it waits
+  std::vector<std::future<int>> sums;
+  for (int i = 0; i < 50; i++)
+  {
+    sums.push_back(spawn(sumHeights(connect_mgr, i * 10, i * 10 + 10)));
+  }
+  int total = 0;
+  for (size_t i = 0; i < sums.size(); i++)
+  {
+    total += sums[i].get();
+  }
+  EXPECT_EQ(499 * 500 / 2, total);
+  EXPECT_EQ(500u, server.requests());
+  EXPECT_LE(server.connections(), 4u);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
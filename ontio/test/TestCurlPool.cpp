@@ -0,0 +1,89 @@
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../src/network/connect/CurlPool.h"
+#include "../src/network/restful/http.h"
+#include "../src/network/rpc/RpcClient.h"
+#include "MockHttpServer.h"
+
+static std::string echo(const std::string &method, const std::string &path,
+                        const std::string &body)
+{
+  return method + " " + path + " " + body;
+}
+
+TEST(CurlPool, KeepAliveTest)
+{
+  CurlPool::clear();
+  MockHttpServer server(echo);
+  for (int i = 0; i < 20; i++)
+  {
+    std::string body = "{\"i\":" + std::to_string(i) + "}";
+    EXPECT_EQ("POST / " + body, CurlPool::post(server.url(), body, false));
+  }
+  EXPECT_EQ("GET /api/v1/x ", CurlPool::get(server.url() + "/api/v1/x", false));
+  EXPECT_EQ(21u, server.requests());
+  EXPECT_EQ(1u, server.connections());
+  EXPECT_EQ(1u, CurlPool::size());
+
+  // one handle per host and per thread
+  MockHttpServer other(echo);
+  EXPECT_EQ("POST / ", CurlPool::post(other.url(), "", false));
+  EXPECT_EQ(2u, CurlPool::size());
+  std::thread worker([&server]() {
+    EXPECT_EQ(0u, CurlPool::size());
+    CurlPool::post(server.url(), "{}", false);
+    EXPECT_EQ(1u, CurlPool::size());
+  });
+  worker.join();
+  EXPECT_EQ(2u, server.connections());
+
+  CurlPool::clear();
+  CurlPool::post(server.url(), "{}", false);
+  EXPECT_EQ(3u, server.connections());
+  CurlPool::clear();
+}
+
+TEST(CurlPool, ClientsTest)
+{
+  MockHttpServer server(
+      [](const std::string &, const std::string &, const std::string &) {
+        return std::string(
+            "{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":0,\"result\":4242}");
+      });
+  RpcClient client(server.url());
+  for (int i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(4242, client.getBlockHeight());
+  }
+  Http http;
+  std::string body;
+  EXPECT_EQ(CURLE_OK, http.curl_get_body(server.url() + "/api/v1/block/height",
+                                         body, false));
+  EXPECT_NE(std::string::npos, body.find("4242"));
+  EXPECT_EQ(11u, server.requests());
+  EXPECT_EQ(1u, server.connections());
+  CurlPool::clear();
+}
+
+TEST(CurlPool, ErrorTest)
+{
+  std::string url;
+  {
+    MockHttpServer server(echo);
+    url = server.url();
+  }
+  EXPECT_THROW(CurlPool::post(url, "{}", false), std::runtime_error);
+  Http http;
+  std::string body;
+  EXPECT_THROW(http.curl_get_body(url, body, false), std::string);
+  CurlPool::clear();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,11 +2,31 @@
 #include "../src/common/Helper.h"
 #include "../src/crypto/Digest.h"
 
+#include <stdlib.h>
+
+#include <new>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+static size_t allocations = 0;
+
+void *operator new(size_t size)
+{
+  allocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
 TEST(SHA256, SHA256Test)
 {
   std::vector<unsigned char> vec{0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9};
@@ -34,6 +54,104 @@ TEST(HASH256, HASH256Test)
   EXPECT_EQ(hash256_2, Helper::toHexString(Digest::hash256(passwordBytes)));
 }
 
+TEST(Sha256Context, StreamingTest)
+{
+  std::vector<unsigned char> vec;
+  for (int i = 0; i < 300; i++)
+  {
+    vec.push_back((unsigned char)(i * 7));
+  }
+  Sha256Context ctx;
+  for (size_t len = 0; len < vec.size(); len += 37)
+  {
+    ctx.init();
+    for (size_t i = 0; i < len; i += 5)
+    {
+      ctx.update(vec.data() + i, std::min<size_t>(5, len - i));
+    }
+    Digest::Hash256 streamed = ctx.final();
+    std::vector<unsigned char> expect = Digest::sha256(vec, 0, (int)len);
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), streamed.begin()));
+
+    ctx.init();
+    Digest::Hash256 hash256 = ctx.update(vec.data(), len).finalHash256();
+    expect = Digest::hash256(vec, 0, (int)len);
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), hash256.begin()));
+  }
+
+  std::vector<unsigned char> hash160 = Digest::hash160(vec);
+  Digest::Hash160 hash160_uc = Digest::hash160(vec.data(), vec.size());
+  EXPECT_TRUE(std::equal(hash160.begin(), hash160.end(), hash160_uc.begin()));
+}
+
+TEST(Sha256Context, NoAllocationTest)
+{
+  unsigned char data[64] = {1, 2, 3};
+  size_t before = allocations;
+  Digest::Hash256 hash256 = Digest::hash256(data, sizeof(data));
+  Digest::Hash160 hash160 = Digest::hash160(data, sizeof(data));
+  Sha256Context ctx;
+  ctx.update(data, 10).update(data + 10, 54);
+  Digest::Hash256 streamed = ctx.finalHash256();
+  EXPECT_EQ(before, allocations);
+  EXPECT_TRUE(hash256 == streamed);
+  EXPECT_NE(0, hash160[0] | hash160[1] | hash160[19]);
+}
+
+TEST(HASH256, BatchTest)
+{
+  std::vector<std::vector<unsigned char>> messages;
+  for (int len = 0; len < 300; len += 3)
+  {
+    std::vector<unsigned char> message(len);
+    for (int i = 0; i < len; i++)
+    {
+      message[i] = (unsigned char)(i * 13 + len);
+    }
+    messages.push_back(message);
+  }
+  Sha256Impl impls[] = {Sha256Impl::AUTO, Sha256Impl::OPENSSL,
+                        Sha256Impl::AVX2};
+  for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++)
+  {
+    std::vector<Digest::Hash256> hashes =
+        Digest::hash256Batch(messages, impls[k]);
+    ASSERT_EQ(messages.size(), hashes.size());
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+      EXPECT_TRUE(Digest::hash256(messages[i].data(), messages[i].size()) ==
+                  hashes[i])
+          << "impl " << k << " length " << messages[i].size();
+    }
+  }
+  EXPECT_TRUE(Digest::hash256Batch({}).empty());
+}
+
+TEST(HASH256, MerkleRootTest)
+{
+  std::vector<Digest::Hash256> leaves;
+  for (int i = 0; i < 5; i++)
+  {
+    unsigned char data = (unsigned char)i;
+    leaves.push_back(Digest::hash256(&data, 1));
+  }
+  Sha256Context ctx;
+  auto node = [&ctx](const Digest::Hash256 &l, const Digest::Hash256 &r) {
+    ctx.init();
+    return ctx.update(l.data(), l.size()).update(r.data(), r.size()).finalHash256();
+  };
+  std::vector<Digest::Hash256> one(leaves.begin(), leaves.begin() + 1);
+  EXPECT_TRUE(leaves[0] == Digest::merkleRoot(one));
+  std::vector<Digest::Hash256> two(leaves.begin(), leaves.begin() + 2);
+  EXPECT_TRUE(node(leaves[0], leaves[1]) == Digest::merkleRoot(two));
+  Digest::Hash256 n01 = node(leaves[0], leaves[1]);
+  Digest::Hash256 n23 = node(leaves[2], leaves[3]);
+  Digest::Hash256 n44 = node(leaves[4], leaves[4]);
+  Digest::Hash256 root = node(node(n01, n23), node(n44, n44));
+  EXPECT_TRUE(root == Digest::merkleRoot(leaves, Sha256Impl::AVX2));
+  EXPECT_TRUE(root == Digest::merkleRoot(leaves, Sha256Impl::OPENSSL));
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -14,6 +14,49 @@ TEST(Base58Test, DecodeTest) {
   EXPECT_EQ(decode_str, Helper::toHexString(vchRet));
 }
 
+TEST(Base58Test, RoundTripTest) {
+  // vectors from the bitcoin base58 test suite
+  const char *vectors[][2] = {
+      {"", ""},
+      {"61", "2g"},
+      {"626262", "a3gV"},
+      {"636363", "aPEr"},
+      {"73696d706c792061206c6f6e6720737472696e67",
+       "2cFupjhnEsSn59qHXstmK2ffpLv2"},
+      {"00eb15231dfceb60925886b67d065299925915aeb172c06647",
+       "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L"},
+      {"516b6fcd0f", "ABnLTmg"},
+      {"bf4f89001e670274dd", "3SEo3LWLoPntC"},
+      {"572e4794", "3EFU7m"},
+      {"ecac89cad93923c02321", "EJDM8drfXA6uyA"},
+      {"10c8511e", "Rt5zm"},
+      {"00000000000000000000", "1111111111"},
+      {"000111d38e5fc9071ffcd20b4a763cc9ae4f252bb4e48fd66a835e252ada93ff480d6d"
+       "d43dc62a641155a5",
+       "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"},
+  };
+  for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+    std::vector<unsigned char> raw = Helper::hexToBytes(vectors[i][0]);
+    EXPECT_EQ(vectors[i][1], Helper::EncodeBase58(raw));
+    std::vector<unsigned char> decoded;
+    EXPECT_TRUE(Helper::DecodeBase58(vectors[i][1], decoded));
+    EXPECT_EQ(raw, decoded);
+  }
+
+  std::vector<unsigned char> raw;
+  for (int len = 0; len < 80; len++) {
+    std::vector<unsigned char> decoded;
+    ASSERT_TRUE(Helper::DecodeBase58(Helper::EncodeBase58(raw), decoded));
+    ASSERT_EQ(raw, decoded);
+    raw.push_back(len < 3 ? 0 : (unsigned char)(len * 97 + 13));
+  }
+
+  std::vector<unsigned char> decoded;
+  EXPECT_TRUE(Helper::DecodeBase58("  2g ", decoded));
+  EXPECT_FALSE(Helper::DecodeBase58("2g 2g", decoded));
+  EXPECT_FALSE(Helper::DecodeBase58("0OIl", decoded));
+}
+
 TEST(BASE64Test, EncodeTest) {
   std::string raw_str = "this is a example";
   std::string no_wrap_target = "dGhpcyBpcyBhIGV4YW1wbGU=";
@@ -34,6 +77,68 @@ TEST(BASE64Test, DecodeTest) {
   EXPECT_EQ(no_padding_raw, target);
 }
 
+TEST(HexTest, RoundTripTest) {
+  std::vector<unsigned char> bytes;
+  for (int len = 0; len < 200; len++) {
+    std::string hex = Helper::toHexString(bytes);
+    ASSERT_EQ(2 + 2 * bytes.size(), hex.size());
+    for (size_t i = 0; i < bytes.size(); i++) {
+      char expect[3];
+      snprintf(expect, sizeof(expect), "%02x", bytes[i]);
+      ASSERT_EQ(expect, hex.substr(2 + 2 * i, 2));
+    }
+    EXPECT_EQ(bytes, Helper::hexStringToByte(hex));
+    EXPECT_EQ(bytes, Helper::hexToBytes(hex.substr(2)));
+    std::vector<unsigned char> upper(hex.begin() + 2, hex.end());
+    for (size_t i = 0; i < upper.size(); i++) {
+      upper[i] = toupper(upper[i]);
+    }
+    EXPECT_EQ(bytes, Helper::hexVecToByte(upper));
+    bytes.push_back((unsigned char)(len * 37 + 11));
+  }
+}
+
+TEST(HexTest, InvalidTest) {
+  std::string hex(160, 'a');
+  const char bad[] = {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\xff'};
+  for (size_t pos = 0; pos < hex.size(); pos += 7) {
+    for (size_t i = 0; i < sizeof(bad); i++) {
+      std::string s = hex;
+      s[pos] = bad[i];
+      EXPECT_THROW(Helper::hexStringToByte(s), std::runtime_error);
+      EXPECT_THROW(Helper::hexToBytes(s), std::runtime_error);
+    }
+  }
+  EXPECT_THROW(Helper::hexStringToByte("0x123"), std::runtime_error);
+}
+
+TEST(BASE64Test, RoundTripTest) {
+  std::vector<unsigned char> raw;
+  for (int len = 0; len < 200; len++) {
+    // reference encoding from OpenSSL
+    std::string target(4 * ((raw.size() + 2) / 3) + 1, '\0');
+    target.resize(EVP_EncodeBlock((unsigned char *)&target[0], raw.data(),
+                                  (int)raw.size()));
+    std::string encoded = Helper::base64Encode(raw, true);
+    ASSERT_EQ(target, encoded);
+    ASSERT_EQ(raw, Helper::base64DecodeBytes(encoded, true));
+    std::string no_padding = Helper::base64Encode(raw, false);
+    ASSERT_EQ(raw, Helper::base64DecodeBytes(no_padding, false));
+    raw.push_back((unsigned char)(len * 53 + (len % 7 == 0 ? 0 : 1)));
+  }
+}
+
+TEST(BASE64Test, WhitespaceAndInvalidTest) {
+  std::string wrapped = "dGhpcyBpcyBh\r\nIGV4YW1w\nbGU=\n";
+  EXPECT_EQ("this is a example", Helper::base64Decode(wrapped, true));
+  EXPECT_EQ("this is a example",
+            Helper::base64Decode("dGhpcyBpcyBhIGV4YW1wbGU", true));
+  EXPECT_THROW(Helper::base64Decode("dGhpcyBpcyBh*GV4YW1wbGU=", true),
+               std::runtime_error);
+  EXPECT_THROW(Helper::base64Decode("dGhp=cyBp", true), std::runtime_error);
+  EXPECT_THROW(Helper::base64Decode("dGhpc", true), std::runtime_error);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
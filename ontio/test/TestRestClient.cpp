@@ -0,0 +1,201 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/network/restful/RestClient.h"
+#include "../src/sdk/manager/ConnectMgr.h"
+#include "MockHttpServer.h"
+
+static std::string response(const std::string &action,
+                            const nlohmann::json &result, int error = 0)
+{
+  nlohmann::json body = {{"Action", action},
+                         {"Desc", error == 0 ? "SUCCESS" : "INVALID PARAMS"},
+                         {"Error", error},
+                         {"Result", result},
+                         {"Version", "1.0.0"}};
+  return body.dump();
+}
+
+static bool startsWith(const std::string &path, const std::string &prefix)
+{
+  return path.compare(0, prefix.size(), prefix) == 0;
+}
+
+// the RESTful API of a node, on the UrlConsts paths
+static std::string node(const std::string &method, const std::string &path,
+                        const std::string &body)
+{
+  if (method == "POST" && startsWith(path, "/api/v1/transaction"))
+  {
+    nlohmann::json request = nlohmann::json::parse(body);
+    if (request["Action"] != "sendrawtransaction" || request["Data"] == "bad")
+    {
+      return response("sendrawtransaction", "", 43001);
+    }
+    if (path == "/api/v1/transaction?preExec=1")
+    {
+      return response("sendrawtransaction",
+                      {{"State", 1}, {"Gas", 20000}, {"Result", "01"}});
+    }
+    return response("sendrawtransaction", request["Data"]);
+  }
+  if (path == "/api/v1/block/height")
+  {
+    return response("getblockheight", 4242);
+  }
+  if (path == "/api/v1/node/connectioncount")
+  {
+    return response("getconnectioncount", 7);
+  }
+  if (path == "/api/v1/node/generateblocktime")
+  {
+    return response("getgenerateblocktime", 6);
+  }
+  if (path == "/api/v1/version")
+  {
+    return response("getversion", "v1.0.3");
+  }
+  if (startsWith(path, "/api/v1/block/details/height/"))
+  {
+    std::string height = path.substr(29, path.find('?') - 29);
+    return response("getblockbyheight",
+                    {{"Height", std::stoi(height)}, {"Query", path}});
+  }
+  if (startsWith(path, "/api/v1/block/details/hash/"))
+  {
+    return response("getblockbyhash", {{"Hash", path.substr(27, 4)}});
+  }
+  if (startsWith(path, "/api/v1/block/height/txhash/"))
+  {
+    return response("getblockheightbytxhash", 100);
+  }
+  if (startsWith(path, "/api/v1/balance/"))
+  {
+    std::string address = path.substr(16);
+    if (address == "bad")
+    {
+      return response("getbalance", "", 43001);
+    }
+    return response("getbalance", {{"ont", address}, {"ong", "0"}});
+  }
+  if (startsWith(path, "/api/v1/contract/"))
+  {
+    return response("getcontract", {{"Code", path.substr(17)}});
+  }
+  if (startsWith(path, "/api/v1/storage/"))
+  {
+    return response("getstorage", path.substr(16));
+  }
+  if (startsWith(path, "/api/v1/allowance/"))
+  {
+    return response("getallowance", "10");
+  }
+  if (startsWith(path, "/api/v1/transaction/"))
+  {
+    if (path.find("raw=1") != std::string::npos)
+    {
+      return response("gettransaction", "00d1");
+    }
+    return response("gettransaction", {{"TxType", 209}});
+  }
+  if (startsWith(path, "/api/v1/smartcode/event/"))
+  {
+    return response("getsmartcodeeventbyheight", nlohmann::json::array());
+  }
+  if (startsWith(path, "/api/v1/merkleproof/"))
+  {
+    return response("getmerkleproof", {{"Type", "MerkleProof"}});
+  }
+  return "not found";
+}
+
+TEST(RestClient, ConnectMgrTest)
+{
+  MockHttpServer server(node);
+  ConnectMgr connect_mgr(server.url(), ConnectType::RESTful);
+
+  EXPECT_EQ(4242, connect_mgr.getBlockHeight());
+  EXPECT_EQ(7, connect_mgr.getNodeCount());
+  EXPECT_EQ(100, connect_mgr.getBlockHeightByTxHash("abcd"));
+  EXPECT_EQ("v1.0.3", connect_mgr.getVersion());
+  EXPECT_EQ("10", connect_mgr.getAllowance("ont", "from", "to"));
+  EXPECT_EQ("0102/0304", connect_mgr.getStorage("0102", "0304"));
+
+  nlohmann::json block = connect_mgr.getBlockJson(12);
+  EXPECT_EQ(12, block["Height"].get<int>());
+  EXPECT_EQ("/api/v1/block/details/height/12?raw=0",
+            block["Query"].get<std::string>());
+  EXPECT_EQ("abcd", connect_mgr.getBlockJson(std::string("abcdef"))["Hash"]
+                        .get<std::string>());
+  EXPECT_EQ("0123", connect_mgr.getContractJson("0123")["Code"]
+                        .get<std::string>());
+
+  nlohmann::json preexec = connect_mgr.sendRawTransactionPreExec("0x00d1");
+  EXPECT_EQ(1, preexec["State"].get<int>());
+
+  std::vector<int> heights;
+  heights.push_back(1);
+  heights.push_back(2);
+  std::vector<nlohmann::json> blocks = connect_mgr.getBlockJsonBatch(heights);
+  ASSERT_EQ(2u, blocks.size());
+  EXPECT_EQ(2, blocks[1]["Height"].get<int>());
+
+  // every request went over one keep-alive connection
+  EXPECT_EQ(1u, server.connections());
+}
+
+TEST(RestClient, InterfacesTest)
+{
+  MockHttpServer server(node);
+  RestClient client(server.url());
+
+  EXPECT_EQ(server.url(), client.getUrl());
+  EXPECT_EQ(6, client.getGenerateBlockTime());
+  EXPECT_EQ("00d1", client.sendRawTransaction("0x00d1").get<std::string>());
+  EXPECT_EQ("00d1", client.getRawTransaction("abcd"));
+  EXPECT_EQ(209, client.getTransactionJson("abcd")["TxType"].get<int>());
+  EXPECT_TRUE(client.getSmartCodeEvent(12).is_array());
+  EXPECT_TRUE(client.getSmartCodeEvent(std::string("abcd")).is_array());
+  EXPECT_EQ("MerkleProof",
+            client.getMerkleProof("abcd")["Type"].get<std::string>());
+
+  std::string address = "AazEvfQPcQ2GEFFPLF1ZLwQ7K5jDn81hve";
+  EXPECT_EQ(address, client.getBalance(address)["ont"].get<std::string>());
+
+  Interfaces rest(server.url());
+  Result result = rest.getBlockHeight();
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ("getblockheight", result.result.Action);
+  EXPECT_EQ("SUCCESS", result.result.Desc);
+  EXPECT_EQ(4242, result.result.Result.get<int>());
+  EXPECT_FALSE(rest.getBalance("bad").ok());
+  EXPECT_EQ(1u, server.connections());
+}
+
+TEST(RestClient, ErrorTest)
+{
+  MockHttpServer server(node);
+  RestClient client(server.url());
+
+  // the node's error
+  EXPECT_THROW(client.getBalance("bad"), std::runtime_error);
+  EXPECT_THROW(client.sendRawTransaction("bad"), std::runtime_error);
+  // a result of the wrong type
+  MockHttpServer numbers(
+      [](const std::string &, const std::string &, const std::string &) {
+        return response("getstorage", 12);
+      });
+  EXPECT_THROW(RestClient(numbers.url()).getStorage("0102", "03"),
+               std::runtime_error);
+  EXPECT_EQ(12, RestClient(numbers.url()).getBlockHeight());
+  // not a response
+  EXPECT_THROW(Interfaces(server.url() + "/nowhere").getNodeCount(),
+               std::runtime_error);
+
+  // nothing listening
+  RestClient closed("http://127.0.0.1:1");
+  EXPECT_THROW(closed.getBlockHeight(), std::runtime_error);
+}
@@ -0,0 +1,107 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/network/rpc/RpcClient.h"
+#include "../src/sdk/manager/ConnectMgr.h"
+#include "MockHttpServer.h"
+
+// answers a JSON-RPC batch in reverse order, so ids have to be matched
+static std::string node(const std::string &, const std::string &,
+                        const std::string &body)
+{
+  nlohmann::json request = nlohmann::json::parse(body);
+  nlohmann::json response = nlohmann::json::array();
+  for (size_t i = request.size(); i-- > 0;)
+  {
+    const nlohmann::json &call = request[i];
+    nlohmann::json item = {{"jsonrpc", "2.0"}, {"id", call["id"]}};
+    std::string method = call["method"];
+    if (method == "getbalance")
+    {
+      std::string address = call["params"][0];
+      item["error"] = address == "bad" ? 42001 : 0;
+      item["result"] = {{"ont", address}, {"ong", "0"}};
+    }
+    else if (method == "getblock")
+    {
+      item["error"] = 0;
+      item["result"] = {{"Height", call["params"][0]}};
+    }
+    response.push_back(item);
+  }
+  return response.dump();
+}
+
+TEST(RpcClient, BatchTest)
+{
+  MockHttpServer server(node);
+  ConnectMgr connect_mgr(server.url(), ConnectType::RPC);
+
+  std::vector<int> heights;
+  for (int h = 100; h < 400; h++)
+  {
+    heights.push_back(h);
+  }
+  std::vector<nlohmann::json> blocks = connect_mgr.getBlockJsonBatch(heights);
+  ASSERT_EQ(heights.size(), blocks.size());
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    EXPECT_EQ(heights[i], blocks[i]["Height"].get<int>());
+  }
+  EXPECT_EQ(1u, server.requests());
+
+  std::vector<std::string> addresses;
+  addresses.push_back("AazEvfQPcQ2GEFFPLF1ZLwQ7K5jDn81hve");
+  addresses.push_back("AMAx993nE6NEqZjwBssUfopxnnvTdob9ij");
+  std::vector<nlohmann::json> balances =
+      connect_mgr.getBalanceBatch(addresses);
+  ASSERT_EQ(2u, balances.size());
+  EXPECT_EQ(addresses[0], balances[0]["ont"].get<std::string>());
+  EXPECT_EQ(addresses[1], balances[1]["ont"].get<std::string>());
+  EXPECT_TRUE(connect_mgr.getBalanceBatch(std::vector<std::string>()).empty());
+  EXPECT_EQ(2u, server.requests());
+
+  addresses.push_back("bad");
+  EXPECT_THROW(connect_mgr.getBalanceBatch(addresses), const char *);
+}
+
+TEST(RpcClient, BatchChunkTest)
+{
+  MockHttpServer server(node);
+  RpcInterfaces rpc(server.url());
+  std::vector<std::pair<std::string, nlohmann::json>> calls;
+  for (int h = 0; h < 10; h++)
+  {
+    calls.push_back(std::make_pair(std::string("getblock"),
+                                   nlohmann::json::array({h, 1})));
+  }
+  std::vector<nlohmann::json> results = rpc.callBatch(calls, 3);
+  ASSERT_EQ(10u, results.size());
+  for (int h = 0; h < 10; h++)
+  {
+    EXPECT_EQ(h, results[h]["Height"].get<int>());
+  }
+  EXPECT_EQ(4u, server.requests());
+}
+
+TEST(RpcClient, BatchMismatchTest)
+{
+  MockHttpServer server(
+      [](const std::string &, const std::string &, const std::string &) {
+        return std::string("[{\"jsonrpc\":\"2.0\",\"id\":7,\"error\":0,"
+                           "\"result\":1}]");
+      });
+  RpcInterfaces rpc(server.url());
+  std::vector<std::pair<std::string, nlohmann::json>> calls(
+      2, std::make_pair(std::string("getblockcount"), nlohmann::json::array()));
+  EXPECT_THROW(rpc.callBatch(calls), const char *);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,4 @@
+#include <future>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -6,6 +7,7 @@
 
 #include "../src/common/Helper.h"
 #include "../src/crypto/ScryptHandler.h"
+#include "../src/crypto/ScryptPool.h"
 
 TEST(ScryptHandlerTest, ScryptTest)
 {
@@ -26,6 +28,62 @@ TEST(ScryptHandlerTest, ScryptTest)
     ASSERT_EQ(target, hex_dkey);
 }
 
+TEST(ScryptHandlerTest, PoolTest)
+{
+    std::vector<unsigned char> salt = Helper::hexStringToByte("0xfaa4883d");
+    ScryptPool pool(2);
+    std::future<std::vector<unsigned char>> dkey =
+        pool.derive(ScryptPool::Job("passwordtest", salt));
+    std::string target =
+        "0x9f0632e05eab137baae6e0a83300341531e8638612a08042d3a4074578869af1ccf500"
+        "8e434d2cae9477f9e6e4c0571ab65a60e32e8c8fc356d95f64dd9717c9";
+    ASSERT_EQ(target, Helper::toHexString(dkey.get()));
+
+    std::future<size_t> size = pool.derive(
+        ScryptPool::Job("passwordtest", salt, 1024, 8, 1, 32),
+        [](std::vector<unsigned char> &key) { return key.size(); });
+    ASSERT_EQ(32u, size.get());
+
+    // n must be a power of 2
+    std::future<std::vector<unsigned char>> bad =
+        pool.derive(ScryptPool::Job("passwordtest", salt, 1000));
+    try
+    {
+        bad.get();
+        FAIL();
+    }
+    catch (SDKException *e)
+    {
+        delete e;
+    }
+}
+
+TEST(ScryptHandlerTest, BatchTest)
+{
+    std::vector<ScryptPool::Job> jobs;
+    for (int i = 0; i < 8; i++)
+    {
+        std::vector<unsigned char> salt(16, (unsigned char)i);
+        jobs.push_back(ScryptPool::Job("password" + std::to_string(i), salt,
+                                       1024, 8, 2, 64));
+    }
+    // room for a single derivation at a time
+    ScryptPool pool(4, ScryptHandler::memoryCost(1024, 8, 2));
+    std::vector<std::vector<unsigned char>> keys = pool.deriveBatch(jobs);
+    ASSERT_EQ(jobs.size(), keys.size());
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        EXPECT_EQ(ScryptHandler::scrypt(jobs[i].password, jobs[i].salt,
+                                        1024, 8, 2, 64),
+                  keys[i]);
+    }
+    // larger than the whole budget, still runs on its own
+    std::vector<unsigned char> salt(16, 0);
+    EXPECT_EQ(64u, pool.derive(ScryptPool::Job("password", salt, 4096, 8, 2))
+                       .get()
+                       .size());
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,11 +1,14 @@
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
 #include "../src/common/Helper.h"
 #include "../src/crypto/ECC.h"
+#include "../src/sdk/manager/WalletMgr.h"
 #include "../src/sdk/wallet/Control.h"
 
 TEST(Control, SaltTest) {
@@ -28,6 +31,103 @@ TEST(Control, toStringTest) {
   EXPECT_EQ(str1, crt.toString());
 }
 
+TEST(UnlockedKeyCache, DerivedKeyTest) {
+  UnlockedKeyCache cache;
+  std::vector<unsigned char> salt(16, 0x5a);
+  std::vector<unsigned char> key = cache.getDerivedKey("password", salt, 1024);
+  EXPECT_EQ(ScryptHandler::scrypt("password", salt, 1024, 8, 8, 64), key);
+  EXPECT_EQ(key, cache.getDerivedKey("password", salt, 1024));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_NE(key, cache.getDerivedKey("passw0rd", salt, 1024));
+  EXPECT_EQ(2u, cache.size());
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(UnlockedKeyCache, BoundsTest) {
+  std::vector<unsigned char> salt(16, 0x5a);
+  UnlockedKeyCache small(2);
+  small.getDerivedKey("a", salt, 1024);
+  small.getDerivedKey("b", salt, 1024);
+  small.getDerivedKey("c", salt, 1024);
+  EXPECT_EQ(2u, small.size());
+
+  UnlockedKeyCache shortLived(8, std::chrono::milliseconds(20));
+  shortLived.getDerivedKey("a", salt, 1024);
+  EXPECT_EQ(1u, shortLived.size());
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  EXPECT_EQ(0u, shortLived.size());
+}
+
+TEST(UnlockedKeyCache, WalletMgrTest) {
+  WalletMgr walletMgr;
+  std::vector<unsigned char> salt(16, 0x5a);
+  walletMgr.getUnlockedKeys().getDerivedKey("password", salt, 1024);
+  EXPECT_EQ(1u, walletMgr.getUnlockedKeys().size());
+  walletMgr.lockAllAccounts();
+  EXPECT_EQ(0u, walletMgr.getUnlockedKeys().size());
+}
+
+TEST(UnlockedKeyCache, AccountPrivateKeyTest) {
+  const std::string private_key =
+      "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de";
+  const SignatureScheme scheme = SignatureScheme::SHA256withECDSA;
+  Account account(private_key);
+  std::string address = account.getAddressU160().toBase58();
+  std::vector<unsigned char> salt(16, 0x5a);
+  std::string encrypted =
+      account.exportGcmEncryptedPrikey("password", salt, 16384);
+
+  WalletMgr walletMgr;
+  UnlockedKeyCache &cache = walletMgr.getUnlockedKeys();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  EXPECT_EQ("0x" + private_key,
+            walletMgr.getAccountPrivateKey(encrypted, "password", address,
+                                           salt, 16384, scheme));
+  std::chrono::steady_clock::duration unlock =
+      std::chrono::steady_clock::now() - start;
+  // the private key and the scrypt key it was decrypted with
+  EXPECT_EQ(2u, cache.size());
+
+  // push the scrypt key out, so only a hit on the private key is fast
+  size_t capacity = UnlockedKeyCache::DEFAULT_CAPACITY;
+  for (size_t i = 0; i < capacity - 1; i++) {
+    cache.getDerivedKey(std::to_string(i), salt, 2);
+  }
+  EXPECT_EQ(capacity, cache.size());
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ("0x" + private_key,
+            walletMgr.getAccountPrivateKey(encrypted, "password", address,
+                                           salt, 16384, scheme));
+  EXPECT_LT((std::chrono::steady_clock::now() - start) * 4, unlock);
+
+  // locking drops the private key, the scrypt key stays
+  walletMgr.lockAllAccounts();
+  walletMgr.getAccountPrivateKey(encrypted, "password", address, salt, 16384,
+                                 scheme);
+  EXPECT_EQ(2u, cache.size());
+  walletMgr.lockAccount(address);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(ScryptHandler::scrypt("password", salt, 16384, 8, 8, 64),
+            cache.getDerivedKey("password", salt, 16384));
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ("0x" + private_key,
+            walletMgr.getAccountPrivateKey(encrypted, "password", address,
+                                           salt, 16384, scheme));
+  EXPECT_EQ(2u, cache.size());
+
+  bool thrown = false;
+  try {
+    walletMgr.getAccountPrivateKey(encrypted, "wrong password", address, salt,
+                                   16384, scheme);
+  } catch (SDKException *e) {
+    thrown = true;
+    delete e;
+  }
+  EXPECT_TRUE(thrown);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
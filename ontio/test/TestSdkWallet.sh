@@ -4,7 +4,7 @@ path=$(
 	pwd
 )
 cd $path
-g++ TestSdkWallet.cpp $(pkg-config --cflags gtest_main --libs openssl libcurl gtest_main) -std=c++11 -o ../bin/test
+g++ TestSdkWallet.cpp $(pkg-config --cflags gtest_main --libs openssl libcurl gtest_main) -std=c++11 -pthread -o ../bin/test
 ../bin/test
 rm ../bin/test &&
 cd $path/../
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "../src/sdk/manager/SignService.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+static std::vector<Account> makeAccounts()
+{
+  std::vector<Account> accounts;
+  accounts.push_back(Account(
+      "15746f42ec429ce1c20647e92154599b644a00644649f03868a2a5962bd2f9de"));
+  accounts.push_back(Account(
+      "49855b16636e70f100cc5f4f42bc20a6535d7414fb8845e7310f8dd065a97221"));
+  return accounts;
+}
+
+static InvokeCodeTransaction makeTx(unsigned char i)
+{
+  std::vector<unsigned char> code(40, i);
+  return InvokeCodeTransaction(code, 0, 30000 + i);
+}
+
+// every account signed the unsigned hash exactly once
+static void expectSigned(InvokeCodeTransaction &tx,
+                         const std::vector<Account> &accounts)
+{
+  ASSERT_EQ((int)accounts.size(), tx.sigs_length());
+  std::vector<unsigned char> hash_data =
+      Digest::hash256(Digest::sha256(tx.getHashData()));
+  for (size_t i = 0; i < accounts.size(); i++)
+  {
+    Account account = accounts[i];
+    Sig sig = tx.get_sig((int)i);
+    ASSERT_EQ(1u, sig.getPubKeys().size());
+    ASSERT_EQ(1u, sig.getSigData().size());
+    EXPECT_EQ(1, sig.getM());
+    std::vector<unsigned char> pub_key = account.serializePublicKey();
+    EXPECT_EQ(std::string(pub_key.begin(), pub_key.end()), sig.getPubKeys()[0]);
+    const std::string &data = sig.getSigData()[0];
+    std::vector<Signature> signatures;
+    signatures.push_back(
+        Signature(std::vector<unsigned char>(data.begin(), data.end())));
+    EXPECT_EQ(65u, data.size());
+    EXPECT_TRUE(account.verifySignature(hash_data, signatures));
+  }
+}
+
+TEST(SignService, SignHashCacheTest)
+{
+  InvokeCodeTransaction tx = makeTx(1);
+  std::vector<unsigned char> hash = tx.hash();
+  std::vector<unsigned char> hash_data = tx.getHashData();
+  EXPECT_EQ(hash_data, tx.hashData());
+  const Digest::Hash256 &sign_hash = tx.signHash();
+  EXPECT_EQ(Digest::hash256(Digest::sha256(hash_data)),
+            std::vector<unsigned char>(sign_hash.begin(), sign_hash.end()));
+  std::vector<unsigned char> data_hash(tx.dataHash().rbegin(),
+                                       tx.dataHash().rend());
+  EXPECT_EQ(hash, data_hash);
+
+  tx.set_gasPrice(500);
+  EXPECT_NE(hash_data, tx.hashData());
+  EXPECT_EQ(tx.getHashData(), tx.hashData());
+  EXPECT_NE(hash, tx.hash());
+  std::vector<unsigned char> gas_hash = tx.hash();
+  tx.set_nonce(7);
+  EXPECT_NE(gas_hash, tx.hash());
+  tx.set_payer(Address());
+  EXPECT_EQ(tx.getHashData(), tx.hashData());
+
+  InvokeCodeTransaction copy;
+  copy.hash();
+  copy = tx;
+  EXPECT_EQ(tx.hash(), copy.hash());
+}
+
+TEST(SignService, SignTxTest)
+{
+  std::vector<Account> accounts = makeAccounts();
+  InvokeCodeTransaction tx = makeTx(1);
+  SignService::signTx(tx, accounts);
+  expectSigned(tx, accounts);
+
+  std::vector<Account> too_many(Common::TX_MAX_SIG_SIZE + 1, accounts[0]);
+  InvokeCodeTransaction other = makeTx(2);
+  EXPECT_ANY_THROW(SignService::signTx(other, too_many));
+}
+
+TEST(SignService, SubmitTest)
+{
+  std::vector<Account> accounts = makeAccounts();
+  std::vector<InvokeCodeTransaction> txs;
+  for (unsigned char i = 0; i < 20; i++)
+  {
+    txs.push_back(makeTx(i));
+  }
+  SignService service(3);
+  EXPECT_EQ(3u, service.threads());
+  std::vector<std::future<InvokeCodeTransaction>> futures =
+      service.submit(txs, accounts);
+  ASSERT_EQ(txs.size(), futures.size());
+  for (size_t i = 0; i < futures.size(); i++)
+  {
+    InvokeCodeTransaction signed_tx = futures[i].get();
+    EXPECT_EQ(0, txs[i].sigs_length());
+    EXPECT_EQ(txs[i].hash(), signed_tx.hash());
+    expectSigned(signed_tx, accounts);
+  }
+
+  std::vector<Account> too_many(Common::TX_MAX_SIG_SIZE + 1, accounts[0]);
+  std::future<InvokeCodeTransaction> failed = service.submit(txs[0], too_many);
+  EXPECT_ANY_THROW(failed.get());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}